@@ -29,6 +29,7 @@
 #include "sprite/sprite_manager.hpp"
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/snapshot.hpp"
 #include "supertux/tile.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
@@ -244,6 +245,34 @@ BadGuy::save(Writer& writer) {
   }
 }
 
+void
+BadGuy::backup(SnapshotWriter& writer) const
+{
+  MovingSprite::backup(writer);
+  writer.write(physic);
+  writer.write(dir);
+  writer.write(frozen);
+  writer.write(ignited);
+  writer.write(state);
+  writer.write(is_active_flag);
+  writer.write(on_ground_flag);
+  state_timer.backup(writer);
+}
+
+void
+BadGuy::restore(SnapshotReader& reader)
+{
+  MovingSprite::restore(reader);
+  reader.read(physic);
+  reader.read(dir);
+  reader.read(frozen);
+  reader.read(ignited);
+  reader.read(state);
+  reader.read(is_active_flag);
+  reader.read(on_ground_flag);
+  state_timer.restore(reader);
+}
+
 Direction
 BadGuy::str2dir(const std::string& dir_str) const
 {
@@ -47,6 +47,8 @@ public:
   virtual void update(float elapsed_time) override;
 
   virtual void save(Writer& writer) override;
+  virtual void backup(SnapshotWriter& writer) const override;
+  virtual void restore(SnapshotReader& reader) override;
   virtual std::string get_class() const override {
     return "badguy";
   }
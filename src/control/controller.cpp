@@ -68,6 +68,17 @@ Controller::hold(Control control) const
   return controls[control];
 }
 
+bool
+Controller::any_hold() const
+{
+  for(int i = 0; i < CONTROLCOUNT; ++i)
+  {
+    if (controls[i])
+      return true;
+  }
+  return false;
+}
+
 bool
 Controller::pressed(Control control) const
 {
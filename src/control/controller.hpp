@@ -60,6 +60,8 @@ public:
   bool pressed(Control control) const;
   /** returns true if the control has just been released this frame */
   bool released(Control control) const;
+  /** returns true if any control is pressed down */
+  bool any_hold() const;
 
   virtual void reset();
   virtual void update();
@@ -192,6 +192,12 @@ MenuManager::event(const SDL_Event& ev)
   }
 }
 
+bool
+MenuManager::needs_redraw() const
+{
+  return m_has_next_dialog || m_transition->is_active();
+}
+
 void
 MenuManager::draw(DrawingContext& context)
 {
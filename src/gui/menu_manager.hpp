@@ -66,6 +66,9 @@ public:
     return !m_menu_stack.empty();
   }
 
+  /** true while a transition or dialog switch is in progress */
+  bool needs_redraw() const;
+
   Menu* current_menu() const;
 
 private:
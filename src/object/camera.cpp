@@ -169,6 +169,7 @@ Camera::Camera(Sector* newsector, const std::string& name_) :
   m_defaultmode(NORMAL),
   m_screen_size(SCREEN_WIDTH, SCREEN_HEIGHT),
   m_translation(),
+  m_previous_translation(),
   m_sector(newsector),
   m_lookahead_mode(LOOKAHEAD_NONE),
   m_changetime(),
@@ -199,6 +200,12 @@ Camera::get_translation() const
   return m_translation;
 }
 
+Vector
+Camera::get_interpolated_translation(float alpha) const
+{
+  return m_previous_translation + (m_translation - m_previous_translation) * alpha;
+}
+
 void
 Camera::parse(const ReaderMapping& reader)
 {
@@ -239,6 +246,7 @@ Camera::reset(const Vector& tuxpos)
   keep_in_bounds(m_translation);
 
   m_cached_translation = m_translation;
+  m_previous_translation = m_translation;
 }
 
 void
@@ -274,6 +282,8 @@ Camera::draw(DrawingContext& context)
 void
 Camera::update(float elapsed_time)
 {
+  m_previous_translation = m_translation;
+
   switch(m_mode) {
     case NORMAL:
       update_scroll_normal(elapsed_time);
@@ -67,6 +67,10 @@ public:
   /** return camera position */
   const Vector& get_translation() const;
 
+  /** return camera position at \a alpha of the way from the
+      position before the last update to the current one */
+  Vector get_interpolated_translation(float alpha) const;
+
   /** shake camera in a direction 1 time */
   void shake(float speed, float x, float y);
 
@@ -74,6 +78,7 @@ public:
   {
     m_translation.x = static_cast<float>(scroll_x);
     m_translation.y = static_cast<float>(scroll_y);
+    m_previous_translation = m_translation;
   }
 
   /** scroll the upper left edge of the camera in scrolltime seconds
@@ -130,6 +135,9 @@ private:
 
   Vector m_translation;
 
+  /** translation before the last update, used for interpolation */
+  Vector m_previous_translation;
+
   Sector* m_sector;
 
   // normal mode
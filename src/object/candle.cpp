@@ -59,6 +59,7 @@ Candle::Candle(const ReaderMapping& lisp)
 
 void
 Candle::after_editor_set() {
+  invalidate_light();
   candle_light_1->set_color(lightcolor);
   candle_light_2->set_color(lightcolor);
 
@@ -82,7 +83,7 @@ Candle::draw(DrawingContext& context)
   sprite->draw(context.color(), get_pos(), layer);
 
   // draw on lightmap
-  if (burning) {
+  if (burning && !is_light_baked()) {
     //Vector pos = get_pos() + (bbox.get_size() - candle_light_1->get_size()) / 2;
     // draw approx. 1 in 10 frames darker. Makes the candle flicker
     if (gameRandom.rand(10) != 0 || !flicker) {
@@ -95,6 +96,20 @@ Candle::draw(DrawingContext& context)
   }
 }
 
+Rectf
+Candle::get_light_bbox() const
+{
+  return get_sprite_light_bbox(*candle_light_1, bbox.get_middle());
+}
+
+void
+Candle::draw_light(Canvas& canvas)
+{
+  if (burning) {
+    candle_light_1->draw(canvas, bbox.get_middle(), 0);
+  }
+}
+
 HitResponse
 Candle::collision(GameObject&, const CollisionHit& )
 {
@@ -125,6 +140,7 @@ Candle::set_burning(bool burning_)
 {
   if (burning == burning_) return;
   burning = burning_;
+  invalidate_light();
   if (burning_) {
     sprite->set_action("on");
   } else {
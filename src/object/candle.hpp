@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_OBJECT_CANDLE_HPP
 
 #include "object/moving_sprite.hpp"
+#include "object/static_light_source.hpp"
 #include "scripting/candle.hpp"
 #include "scripting/exposed_object.hpp"
 
@@ -25,7 +26,8 @@
  * A burning candle: Simple, scriptable level decoration.
  */
 class Candle final : public MovingSprite,
-               public ExposedObject<Candle, scripting::Candle>
+               public ExposedObject<Candle, scripting::Candle>,
+               public StaticLightSource
 {
 public:
   Candle(const ReaderMapping& lisp);
@@ -33,6 +35,11 @@ public:
 
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
 
+  /** Only a candle that doesn't flicker can be baked */
+  virtual bool is_light_static() const override { return !flicker; }
+  virtual Rectf get_light_bbox() const override;
+  virtual void draw_light(Canvas& canvas) override;
+
   /**
    * @name Scriptable Methods
    * @{
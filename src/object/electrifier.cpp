@@ -23,9 +23,7 @@ Electrifier::Electrifier(TileChangeMap replacements, float seconds) :
   duration()
 {
   duration.start(seconds);
-  for(auto& tile : change_map) {
-    Sector::get().change_solid_tiles(tile.first, tile.second);
-  }
+  Sector::get().change_solid_tiles({ change_map.begin(), change_map.end() });
 }
 
 Electrifier::Electrifier(uint32_t oldtile, uint32_t newtile, float seconds) :
@@ -39,9 +37,11 @@ void
 Electrifier::update(float )
 {
   if (duration.check()) {
+    std::vector<std::pair<uint32_t, uint32_t> > replacements;
     for(const auto& tile : change_map){
-      Sector::get().change_solid_tiles(tile.second, tile.first);
+      replacements.emplace_back(tile.second, tile.first);
     }
+    Sector::get().change_solid_tiles(replacements);
     remove_me();
   }
 }
@@ -68,6 +68,7 @@ Lantern::after_editor_set() {
 void
 Lantern::updateColor(){
   lightsprite->set_color(lightcolor);
+  invalidate_light();
   //Turn lantern off if light is black
   if(lightcolor.red == 0 && lightcolor.green == 0 && lightcolor.blue == 0){
     sprite->set_action("off");
@@ -83,7 +84,27 @@ Lantern::draw(DrawingContext& context){
   //Draw the Sprite.
   MovingSprite::draw(context);
   //Let there be light.
-  lightsprite->draw(context.light(), bbox.get_middle(), 0);
+  if (!is_light_baked()) {
+    draw_light(context.light());
+  }
+}
+
+bool
+Lantern::is_light_static() const
+{
+  return on_ground && !grabbed;
+}
+
+Rectf
+Lantern::get_light_bbox() const
+{
+  return get_sprite_light_bbox(*lightsprite, bbox.get_middle());
+}
+
+void
+Lantern::draw_light(Canvas& canvas)
+{
+  lightsprite->draw(canvas, bbox.get_middle(), 0);
 }
 
 HitResponse Lantern::collision(GameObject& other, const CollisionHit& hit) {
@@ -18,11 +18,13 @@
 #define HEADER_SUPERTUX_OBJECT_LANTERN_HPP
 
 #include "object/rock.hpp"
+#include "object/static_light_source.hpp"
 
 /**
  * Lantern. A portable Light Source.
  */
-class Lantern final : public Rock
+class Lantern final : public Rock,
+                      public StaticLightSource
 {
 public:
   Lantern(const Vector& pos);
@@ -34,6 +36,11 @@ public:
   virtual void grab(MovingObject& object, const Vector& pos, Direction dir) override;
   virtual void ungrab(MovingObject& object, Direction dir) override;
 
+  /** A lantern is only baked while it rests on the ground */
+  virtual bool is_light_static() const override;
+  virtual Rectf get_light_bbox() const override;
+  virtual void draw_light(Canvas& canvas) override;
+
   /**
    * returns true if lamp is currently open
    */
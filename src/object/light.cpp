@@ -37,10 +37,25 @@ Light::update(float )
 
 void
 Light::draw(DrawingContext& context)
+{
+  if (!is_light_baked())
+  {
+    draw_light(context.light());
+  }
+}
+
+Rectf
+Light::get_light_bbox() const
+{
+  return get_sprite_light_bbox(*sprite, position);
+}
+
+void
+Light::draw_light(Canvas& canvas)
 {
   sprite->set_color(color);
   sprite->set_blend(Blend::ADD);
-  sprite->draw(context.light(), position, 0);
+  sprite->draw(canvas, position, 0);
 }
 
 /* EOF */
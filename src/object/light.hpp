@@ -18,11 +18,13 @@
 #define HEADER_SUPERTUX_OBJECT_LIGHT_HPP
 
 #include "math/vector.hpp"
+#include "object/static_light_source.hpp"
 #include "sprite/sprite_ptr.hpp"
 #include "supertux/game_object.hpp"
 #include "video/color.hpp"
 
-class Light : public GameObject
+class Light : public GameObject,
+              public StaticLightSource
 {
 public:
   Light(const Vector& center, const Color& color = Color(1.0, 1.0, 1.0, 1.0));
@@ -34,6 +36,10 @@ public:
   virtual void update(float elapsed_time) override;
   virtual void draw(DrawingContext& context) override;
 
+  virtual bool is_light_static() const override { return true; }
+  virtual Rectf get_light_bbox() const override;
+  virtual void draw_light(Canvas& canvas) override;
+
 protected:
   Vector position;
   Color color;
@@ -24,6 +24,7 @@
 #include "object/sprite_particle.hpp"
 #include "sprite/sprite_manager.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/snapshot.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
 
@@ -129,12 +130,39 @@ MovingSprite::update(float )
 {
 }
 
+void
+MovingSprite::backup(SnapshotWriter& writer) const
+{
+  MovingObject::backup(writer);
+  // handles are stable for the session, which is as long as
+  // snapshots live
+  writer.write(static_cast<int32_t>(sprite->get_current_action().get_id()));
+}
+
+void
+MovingSprite::restore(SnapshotReader& reader)
+{
+  MovingObject::restore(reader);
+  int32_t id;
+  reader.read(id);
+  const ActionHandle action(id);
+  // bbox was restored already, so don't go through set_action() here
+  if (sprite->has_action(action))
+    sprite->set_action(action);
+}
+
 std::string
 MovingSprite::get_sprite_name() const
 {
   return sprite_name;
 }
 
+void
+MovingSprite::prefetch_textures() const
+{
+  sprite->prefetch();
+}
+
 void
 MovingSprite::set_action(const std::string& action, int loops)
 {
@@ -142,6 +170,13 @@ MovingSprite::set_action(const std::string& action, int loops)
   set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 }
 
+void
+MovingSprite::set_action(ActionHandle action, int loops)
+{
+  sprite->set_action(action, loops);
+  set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+}
+
 void
 MovingSprite::set_action_centered(const std::string& action, int loops)
 {
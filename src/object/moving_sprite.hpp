@@ -55,6 +55,8 @@ public:
     return "moving-sprite";
   }
   virtual void save(Writer& writer) override;
+  virtual void backup(SnapshotWriter& writer) const override;
+  virtual void restore(SnapshotReader& reader) override;
   virtual std::string get_default_sprite_name() const {
     return default_sprite_name;
   }
@@ -66,6 +68,9 @@ public:
   void change_sprite(const std::string& new_sprite_name);
   void spawn_explosion_sprites(int count, const std::string& sprite_path);
 
+  /** Pages in the sprite's textures before the object becomes visible */
+  void prefetch_textures() const;
+
 protected:
   std::string sprite_name;
 
@@ -79,6 +84,7 @@ protected:
   /** set new action for sprite and resize bounding box.  use with
       care as you can easily get stuck when resizing the bounding box. */
   void set_action(const std::string& action, int loops);
+  void set_action(ActionHandle action, int loops);
 
   /** set new action for sprite and re-center bounding box.  use with
       care as you can easily get stuck when resizing the bounding
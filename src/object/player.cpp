@@ -35,8 +35,10 @@
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/snapshot.hpp"
 #include "supertux/tile.hpp"
 #include "trigger/trigger_base.hpp"
+#include "util/string_util.hpp"
 #include "video/surface.hpp"
 
 //#define SWIMMING
@@ -55,13 +57,82 @@ static const unsigned int IDLE_STAGE_COUNT = 5;
  * animation
  */
 static const int IDLE_TIME[] = { 5000, 0, 2500, 0, 2500 };
+/** actions that every bonus of Tux has, as "<bonus>-<action>-<direction>" */
+enum TuxAction {
+  TUX_CLIMBING,
+  TUX_BACKFLIP,
+  TUX_DUCK,
+  TUX_SKID,
+  TUX_KICK,
+  TUX_BUTTJUMP,
+  TUX_JUMP,
+  TUX_STAND,
+  TUX_IDLE,
+  TUX_RUN,
+  TUX_WALK,
+  TUX_ACTION_COUNT
+};
+static const char* const TUX_ACTION_NAMES[] =
+{ "climbing", "backflip", "duck", "skid", "kick", "buttjump",
+  "jump", "stand", "idle", "run", "walk" };
+/** looks of Tux, in the order of TUX_BONUS_NAMES */
+enum TuxBonus {
+  TUX_SMALL,
+  TUX_BIG,
+  TUX_FIRE,
+  TUX_SANTA,
+  TUX_ICE,
+  TUX_AIR,
+  TUX_EARTH,
+  TUX_BONUS_COUNT
+};
+static const char* const TUX_BONUS_NAMES[] =
+{ "small", "big", "fire", "santa", "ice", "air", "earth" };
+
 /** idle stages */
-static const std::string IDLE_STAGES[] =
-{ "stand",
-  "idle",
-  "stand",
-  "idle",
-  "stand" };
+static const TuxAction IDLE_STAGES[] =
+{ TUX_STAND,
+  TUX_IDLE,
+  TUX_STAND,
+  TUX_IDLE,
+  TUX_STAND };
+
+/** Returns the handle of the action for the given bonus; the names
+    are built once instead of on every draw() */
+static ActionHandle get_tux_action(TuxBonus bonus, TuxAction action, Direction dir)
+{
+  static const std::vector<ActionHandle> handles = [] {
+    std::vector<ActionHandle> result;
+    for (int i = 0; i < TUX_BONUS_COUNT; ++i) {
+      for (int j = 0; j < TUX_ACTION_COUNT; ++j) {
+        const std::string name = std::string(TUX_BONUS_NAMES[i]) + "-" + TUX_ACTION_NAMES[j];
+        result.push_back(Sprite::get_action_handle(name + "-left"));
+        result.push_back(Sprite::get_action_handle(name + "-right"));
+      }
+    }
+    return result;
+  }();
+  return handles[(bonus * TUX_ACTION_COUNT + action) * 2 + (dir == LEFT ? 0 : 1)];
+}
+
+/** Returns the handle of the stone form of \a action, e.g.
+    "earth-walk-right-stone", a stone action is its own stone form;
+    the name is only built the first time an action turns to stone */
+static ActionHandle get_stone_action(ActionHandle action)
+{
+  static std::vector<ActionHandle> stone_actions;
+  const size_t id = static_cast<size_t>(action.get_id());
+  if (id >= stone_actions.size()) {
+    stone_actions.resize(id + 1);
+  }
+
+  if (!stone_actions[id].is_valid()) {
+    const std::string& name = action.get_name();
+    stone_actions[id] = StringUtil::has_suffix(name, "-stone") ?
+      action : Sprite::get_action_handle(name + "-stone");
+  }
+  return stone_actions[id];
+}
 
 /** acceleration in horizontal direction when walking
  * (all accelerations are in  pixel/s^2) */
@@ -1167,64 +1238,60 @@ Player::draw(DrawingContext& context)
     context.color().draw_surface(m_airarrow, Vector(px, py), LAYER_HUD - 1);
   }
 
-  std::string sa_prefix = "";
-  std::string sa_postfix = "";
-
+  TuxBonus bonus;
   if (m_player_status.bonus == GROWUP_BONUS)
-    sa_prefix = "big";
+    bonus = TUX_BIG;
   else if (m_player_status.bonus == FIRE_BONUS)
     if(g_config->christmas_mode)
-      sa_prefix = "santa";
+      bonus = TUX_SANTA;
     else
-      sa_prefix = "fire";
+      bonus = TUX_FIRE;
   else if (m_player_status.bonus == ICE_BONUS)
-    sa_prefix = "ice";
+    bonus = TUX_ICE;
   else if (m_player_status.bonus == AIR_BONUS)
-    sa_prefix = "air";
+    bonus = TUX_AIR;
   else if (m_player_status.bonus == EARTH_BONUS)
-    sa_prefix = "earth";
-  else
-    sa_prefix = "small";
-
-  if(m_dir == LEFT)
-    sa_postfix = "-left";
+    bonus = TUX_EARTH;
   else
-    sa_postfix = "-right";
+    bonus = TUX_SMALL;
 
   /* Set Tux sprite action */
   if(m_dying) {
-    m_sprite->set_action("gameover");
+    static const ActionHandle gameover = Sprite::get_action_handle("gameover");
+    m_sprite->set_action(gameover);
   }
   else if (m_growing) {
-    m_sprite->set_action_continued("grow"+sa_postfix);
+    static const ActionHandle grow_left = Sprite::get_action_handle("grow-left");
+    static const ActionHandle grow_right = Sprite::get_action_handle("grow-right");
+    m_sprite->set_action_continued(m_dir == LEFT ? grow_left : grow_right);
     // while growing, do not change action
     // do_duck() will take care of cancelling growing manually
     // update() will take care of cancelling when growing completed
   }
   else if (m_stone) {
-    m_sprite->set_action(m_sprite->get_action()+"-stone");
+    m_sprite->set_action(get_stone_action(m_sprite->get_current_action()));
   }
   else if (m_climbing) {
-    m_sprite->set_action(sa_prefix+"-climbing"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_CLIMBING, m_dir));
   }
   else if (m_backflipping) {
-    m_sprite->set_action(sa_prefix+"-backflip"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_BACKFLIP, m_dir));
   }
   else if (m_duck && is_big()) {
-    m_sprite->set_action(sa_prefix+"-duck"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_DUCK, m_dir));
   }
   else if (m_skidding_timer.started() && !m_skidding_timer.check()) {
-    m_sprite->set_action(sa_prefix+"-skid"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_SKID, m_dir));
   }
   else if (m_kick_timer.started() && !m_kick_timer.check()) {
-    m_sprite->set_action(sa_prefix+"-kick"+sa_postfix);
+    m_sprite->set_action(get_tux_action(bonus, TUX_KICK, m_dir));
   }
   else if ((m_wants_buttjump || m_does_buttjump) && is_big()) {
-    m_sprite->set_action(sa_prefix+"-buttjump"+sa_postfix, 1);
+    m_sprite->set_action(get_tux_action(bonus, TUX_BUTTJUMP, m_dir), 1);
   }
   else if (!on_ground() || m_fall_mode != ON_GROUND) {
     if(m_physic.get_velocity_x() != 0 || m_fall_mode != ON_GROUND) {
-        m_sprite->set_action(sa_prefix+"-jump"+sa_postfix);
+        m_sprite->set_action(get_tux_action(bonus, TUX_JUMP, m_dir));
     }
   }
   else {
@@ -1234,7 +1301,7 @@ Player::draw(DrawingContext& context)
         m_idle_stage = 0;
         m_idle_timer.start(static_cast<float>(IDLE_TIME[m_idle_stage]) / 1000.0f);
 
-        m_sprite->set_action_continued(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+        m_sprite->set_action_continued(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], m_dir));
       }
       else if (m_idle_timer.check() || (IDLE_TIME[m_idle_stage] == 0 && m_sprite->animation_done())) {
         m_idle_stage++;
@@ -1244,31 +1311,31 @@ Player::draw(DrawingContext& context)
         m_idle_timer.start(static_cast<float>(IDLE_TIME[m_idle_stage]) / 1000.0f);
 
         if (IDLE_TIME[m_idle_stage] == 0)
-          m_sprite->set_action(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix, 1);
+          m_sprite->set_action(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], m_dir), 1);
         else
-          m_sprite->set_action(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+          m_sprite->set_action(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], m_dir));
       }
       else {
-        m_sprite->set_action_continued(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+        m_sprite->set_action_continued(get_tux_action(bonus, IDLE_STAGES[m_idle_stage], m_dir));
       }
     }
     else {
       if(fabsf(m_physic.get_velocity_x()) > MAX_WALK_XM && !is_big()) {
-        m_sprite->set_action(sa_prefix+"-run"+sa_postfix);
+        m_sprite->set_action(get_tux_action(bonus, TUX_RUN, m_dir));
       } else {
-        m_sprite->set_action(sa_prefix+"-walk"+sa_postfix);
+        m_sprite->set_action(get_tux_action(bonus, TUX_WALK, m_dir));
       }
     }
   }
 
   /* Set Tux powerup sprite action */
   if (m_player_status.bonus == EARTH_BONUS) {
-    m_powersprite->set_action(m_sprite->get_action());
-    m_lightsprite->set_action(m_sprite->get_action());
+    m_powersprite->set_action(m_sprite->get_current_action());
+    m_lightsprite->set_action(m_sprite->get_current_action());
   } else if (m_player_status.bonus == AIR_BONUS) {
-    m_powersprite->set_action(m_sprite->get_action());
+    m_powersprite->set_action(m_sprite->get_current_action());
   } else if (m_player_status.bonus == FIRE_BONUS && g_config->christmas_mode) {
-    m_powersprite->set_action(m_sprite->get_action());
+    m_powersprite->set_action(m_sprite->get_current_action());
   }
 
   /*
@@ -1346,6 +1413,38 @@ Player::collision_tile(uint32_t tile_attributes)
   }
 }
 
+void
+Player::backup(SnapshotWriter& writer) const
+{
+  MovingObject::backup(writer);
+  writer.write(m_physic);
+  writer.write(m_dir);
+  writer.write(m_duck);
+  writer.write(m_on_ground_flag);
+  writer.write(m_jumping);
+  writer.write(m_can_jump);
+  writer.write(m_backflipping);
+  m_invincible_timer.backup(writer);
+  m_safe_timer.backup(writer);
+  m_backflip_timer.backup(writer);
+}
+
+void
+Player::restore(SnapshotReader& reader)
+{
+  MovingObject::restore(reader);
+  reader.read(m_physic);
+  reader.read(m_dir);
+  reader.read(m_duck);
+  reader.read(m_on_ground_flag);
+  reader.read(m_jumping);
+  reader.read(m_can_jump);
+  reader.read(m_backflipping);
+  m_invincible_timer.restore(reader);
+  m_safe_timer.restore(reader);
+  m_backflip_timer.restore(reader);
+}
+
 void
 Player::collision_solid(const CollisionHit& hit)
 {
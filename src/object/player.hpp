@@ -80,6 +80,8 @@ public:
   virtual void collision_solid(const CollisionHit& hit) override;
   virtual HitResponse collision(GameObject& other, const CollisionHit& hit) override;
   virtual void collision_tile(uint32_t tile_attributes) override;
+  virtual void backup(SnapshotWriter& writer) const override;
+  virtual void restore(SnapshotReader& reader) override;
 
   void make_invincible();
   bool is_invincible() const
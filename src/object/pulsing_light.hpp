@@ -31,6 +31,9 @@ public:
   virtual void update(float elapsed_time) override;
   virtual void draw(DrawingContext& context) override;
 
+  /** The alpha changes every frame, so it can't be baked */
+  virtual bool is_light_static() const override { return false; }
+
 protected:
   float min_alpha; /**< minimum alpha */
   float max_alpha; /**< maximum alpha */
@@ -0,0 +1,78 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_OBJECT_STATIC_LIGHT_SOURCE_HPP
+#define HEADER_SUPERTUX_OBJECT_STATIC_LIGHT_SOURCE_HPP
+
+#include "math/rectf.hpp"
+#include "sprite/sprite.hpp"
+
+class Canvas;
+
+/**
+ * An object that inherits from this is a light source that can be
+ * baked into the StaticLightmap of its Sector while it neither moves
+ * nor animates. A baked light must not draw itself into the lightmap
+ * anymore, that is done by the chunk it got baked into.
+ */
+class StaticLightSource
+{
+public:
+  StaticLightSource() :
+    m_light_baked(false),
+    m_light_changed(false)
+  {}
+
+  virtual ~StaticLightSource()
+  {}
+
+  /** Returns true if the light currently looks the same from frame
+      to frame, only then it will be baked */
+  virtual bool is_light_static() const = 0;
+
+  /** The area in sector coordinates that is touched by the light */
+  virtual Rectf get_light_bbox() const = 0;
+
+  /** Draw the light, either into the lightmap or into a baked chunk */
+  virtual void draw_light(Canvas& canvas) = 0;
+
+  void set_light_baked(bool baked) { m_light_baked = baked; }
+  bool is_light_baked() const { return m_light_baked; }
+
+  /** Has to be called whenever the look of a static light changes,
+      e.g. when it is switched on or off from a script */
+  void invalidate_light() { m_light_changed = true; }
+  bool is_light_changed() const { return m_light_changed; }
+  void clear_light_changed() { m_light_changed = false; }
+
+protected:
+  /** Returns the area covered by a light sprite drawn at \a pos */
+  static Rectf get_sprite_light_bbox(const Sprite& sprite, const Vector& pos)
+  {
+    return Rectf(pos - Vector(sprite.get_current_hitbox_x_offset(),
+                              sprite.get_current_hitbox_y_offset()),
+                 Sizef(static_cast<float>(sprite.get_width()),
+                       static_cast<float>(sprite.get_height())));
+  }
+
+private:
+  bool m_light_baked;
+  bool m_light_changed;
+};
+
+#endif
+
+/* EOF */
@@ -20,22 +20,42 @@
 #include <cmath>
 
 #include "editor/editor.hpp"
+#include "object/camera.hpp"
+#include "supertux/debug.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/snapshot.hpp"
 #include "supertux/tile.hpp"
 #include "supertux/tile_set.hpp"
 #include "util/reader.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/tile_encoding.hpp"
 #include "util/writer.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
 
+bool TileMap::s_compact_tiles = false;
+
+namespace {
+
+const float PAGE_OUT_INTERVAL = 1.0f;
+
+/** the journal only has to reach back as far as the snapshots, which
+    cover a few seconds */
+const size_t MAX_TILE_CHANGES = 1 << 16;
+
+} // namespace
+
 TileMap::TileMap(const TileSet *new_tileset) :
   ExposedObject<TileMap, scripting::TileMap>(this),
   PathObject(),
   m_editor_active(true),
   m_tileset(new_tileset),
   m_tiles(),
+  m_paged(false),
+  m_page_timer(),
+  m_tile_changes(),
+  m_tile_changes_base(0),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -45,6 +65,7 @@ TileMap::TileMap(const TileSet *new_tileset) :
   m_z_pos(0),
   m_offset(Vector(0,0)),
   m_movement(0,0),
+  m_previous_offset(0,0),
   m_flip(NO_FLIP),
   m_alpha(1.0),
   m_current_alpha(1.0),
@@ -69,6 +90,10 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_editor_active(true),
   m_tileset(tileset_),
   m_tiles(),
+  m_paged(false),
+  m_page_timer(),
+  m_tile_changes(),
+  m_tile_changes_base(0),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -78,6 +103,7 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_z_pos(0),
   m_offset(Vector(0,0)),
   m_movement(Vector(0,0)),
+  m_previous_offset(Vector(0,0)),
   m_flip(NO_FLIP),
   m_alpha(1.0),
   m_current_alpha(1.0),
@@ -136,6 +162,7 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_effective_solid = m_real_solid;
   update_effective_solid ();
 
+  std::vector<uint32_t> tiles;
   reader.get("width", m_width);
   reader.get("height", m_height);
   if(m_width < 0 || m_height < 0) {
@@ -147,23 +174,47 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
            static_cast<int>(Sector::get().get_height() / 32.0f));
     m_editor_active = false;
   } else {
-    if(!reader.get("tiles", m_tiles))
+    std::string compact_tiles;
+    if(reader.get("tiles-rle", compact_tiles)) {
+      // the count is checked while decoding, so that a broken run
+      // can't allocate more than the map holds
+      tiles = TileEncoding::decode(compact_tiles,
+                                   static_cast<size_t>(m_width) * static_cast<size_t>(m_height));
+    } else if(!reader.get("tiles", tiles)) {
       throw std::runtime_error("No tiles in tilemap.");
+    }
 
-    if(int(m_tiles.size()) != m_width * m_height) {
+    if(int(tiles.size()) != m_width * m_height) {
       throw std::runtime_error("wrong number of tiles in tilemap.");
     }
+
+    set_tiles(m_width, m_height, tiles);
   }
 
   bool empty = true;
 
-  // make sure all tiles used on the tilemap are loaded and tilemap isn't empty
-  for(const auto& tile : m_tiles) {
+  // queue the images of the tiles used on the tilemap, so that they
+  // get decoded in parallel, and make sure the tilemap isn't empty
+  std::vector<bool> seen(m_tileset->get_max_tileid());
+  std::vector<const Tile*> used_tiles;
+  for(const auto& tile : tiles) {
     if(tile != 0) {
       empty = false;
     }
 
-    m_tileset->get(tile);
+    if(tile < seen.size() && !seen[tile]) {
+      seen[tile] = true;
+      const Tile& used_tile = m_tileset->get(tile);
+      used_tile.preload();
+      used_tiles.push_back(&used_tile);
+    }
+  }
+
+  // create the surfaces now, unclaimed preloads and decoded tile
+  // sheets get dropped before the tiles would be drawn for the first
+  // time, which would decode them again on the main thread mid-game
+  for(const auto* used_tile : used_tiles) {
+    used_tile->load_images();
   }
 
   if(empty)
@@ -183,6 +234,132 @@ void TileMap::float_channel(float target, float &current, float remaining_time,
   if (amt < 0) current = std::max(current + amt, target);
 }
 
+void
+TileMap::set_tiles(int width, int height, const std::vector<uint32_t>& tiles)
+{
+  // a large tilemap starts out packed, the pages get unpacked when
+  // they are drawn or collided with for the first time
+  m_paged = (width * height >= PAGED_TILE_COUNT) && !Editor::is_active();
+  m_tiles.assign(width, height, tiles, m_paged);
+  // the palette indices in the journal refer to the old tiles
+  forget_tile_changes();
+  if (m_paged) {
+    m_page_timer.start(PAGE_OUT_INTERVAL, true);
+  }
+}
+
+void
+TileMap::pack_unused_pages()
+{
+  // worldmap tilemaps get updated outside of any sector, they stay
+  // unpacked
+  const Sector* sector = Sector::current();
+  if (!sector || !sector->m_camera)
+    return;
+
+  // the region that keeps badguys active, scrolled the way draw()
+  // scrolls this tilemap
+  const Vector& translation = sector->m_camera->get_translation();
+  Rectf region = sector->get_active_region();
+  region.move(Vector(translation.x * (m_speed_x - 1.0f),
+                     translation.y * (m_speed_y - 1.0f)));
+
+  m_tiles.pack_outside(get_tiles_overlapping(region));
+}
+
+void
+TileMap::backup(SnapshotWriter& writer) const
+{
+  // the tiles themselves are journaled as they change
+  writer.write(m_tile_changes_base + static_cast<uint64_t>(m_tile_changes.size()));
+  writer.write(m_offset.x);
+  writer.write(m_offset.y);
+  writer.write(m_movement.x);
+  writer.write(m_movement.y);
+  writer.write(m_alpha);
+  writer.write(m_current_alpha);
+  writer.write(m_remaining_fade_time);
+  writer.write(m_effective_solid);
+}
+
+void
+TileMap::restore(SnapshotReader& reader)
+{
+  uint64_t revision;
+  reader.read(revision);
+  undo_tile_changes(revision);
+  reader.read(m_offset.x);
+  reader.read(m_offset.y);
+  m_previous_offset = m_offset;
+  reader.read(m_movement.x);
+  reader.read(m_movement.y);
+  reader.read(m_alpha);
+  reader.read(m_current_alpha);
+  reader.read(m_remaining_fade_time);
+  reader.read(m_effective_solid);
+}
+
+void
+TileMap::record_tile_change(bool palette, uint32_t pos, uint32_t old_value)
+{
+  if (!g_debug.record_snapshots) {
+    forget_tile_changes();
+    return;
+  }
+
+  m_tile_changes.push_back({ palette, pos, old_value });
+  if (m_tile_changes.size() > MAX_TILE_CHANGES) {
+    const size_t count = MAX_TILE_CHANGES / 2;
+    m_tile_changes.erase(m_tile_changes.begin(), m_tile_changes.begin() + count);
+    m_tile_changes_base += count;
+  }
+}
+
+void
+TileMap::record_palette_changes(const std::vector<uint32_t>& old_palette)
+{
+  if (!g_debug.record_snapshots) {
+    forget_tile_changes();
+    return;
+  }
+
+  const auto& palette = m_tiles.get_palette();
+  for(size_t i = 0; i < old_palette.size(); ++i) {
+    if (palette[i] != old_palette[i]) {
+      record_tile_change(true, static_cast<uint32_t>(i), old_palette[i]);
+    }
+  }
+}
+
+void
+TileMap::forget_tile_changes()
+{
+  // skip a revision so snapshots taken before this point can't match
+  m_tile_changes_base += m_tile_changes.size() + 1;
+  m_tile_changes.clear();
+}
+
+void
+TileMap::undo_tile_changes(uint64_t revision)
+{
+  if (revision < m_tile_changes_base) {
+    log_warning << "tile changes of the snapshot are no longer known, keeping the current tiles" << std::endl;
+    return;
+  }
+
+  while (m_tile_changes_base + m_tile_changes.size() > revision) {
+    const TileChange& change = m_tile_changes.back();
+    if (change.palette) {
+      m_tiles.set_palette_entry(change.pos, change.old_value);
+    } else {
+      m_tiles.set_index_at(static_cast<int>(change.pos % static_cast<uint32_t>(m_width)),
+                           static_cast<int>(change.pos / static_cast<uint32_t>(m_width)),
+                           change.old_value);
+    }
+    m_tile_changes.pop_back();
+  }
+}
+
 void
 TileMap::save(Writer& writer) {
   GameObject::save(writer);
@@ -206,7 +383,11 @@ TileMap::save(Writer& writer) {
   if(path) {
     path->save(writer);
   }
-  writer.write("tiles", m_tiles);
+  if(s_compact_tiles) {
+    writer.write("tiles-rle", TileEncoding::encode(m_tiles.get_all()), false);
+  } else {
+    writer.write("tiles", m_tiles.get_all());
+  }
 }
 
 ObjectSettings
@@ -296,6 +477,7 @@ TileMap::update(float elapsed_time)
     }
   }
 
+  m_previous_offset = m_offset;
   m_movement = Vector(0,0);
   // if we have a path to follow, follow it
   if (walker.get()) {
@@ -307,10 +489,37 @@ TileMap::update(float elapsed_time)
       set_offset(Vector(0, 0));
     }
   }
+
+  if (m_paged && m_page_timer.check()) {
+    pack_unused_pages();
+  }
+}
+
+Vector
+TileMap::get_interpolated_offset(float alpha) const
+{
+  // same limit as for MovingObjects, anything faster got teleported
+  static const float max_distance = 64.0f;
+
+  const Vector delta = m_offset - m_previous_offset;
+  if (fabsf(delta.x) > max_distance || fabsf(delta.y) > max_distance)
+  {
+    return m_offset;
+  }
+  else
+  {
+    return m_previous_offset + delta * alpha;
+  }
 }
 
 void
 TileMap::draw(DrawingContext& context)
+{
+  draw(context, 1.0f);
+}
+
+void
+TileMap::draw(DrawingContext& context, float alpha)
 {
   // skip draw if current opacity is 0.0
   if (m_current_alpha == 0.0) return;
@@ -337,9 +546,14 @@ TileMap::draw(DrawingContext& context)
   context.set_translation(Vector(std::truncf(trans_x * (normal_speed ? 1.0f : m_speed_x)),
                                  std::truncf(trans_y * (normal_speed ? 1.0f : m_speed_y))));
 
+  // a tilemap following a path is drawn in step with the objects
+  // riding on it
+  const Vector shift = get_interpolated_offset(alpha) - m_offset;
+
   Rectf draw_rect = context.get_cliprect();
+  draw_rect.move(-shift);
   Rect t_draw_rect = get_tiles_overlapping(draw_rect);
-  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
+  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top) + shift;
 
   Vector pos;
   int tx, ty;
@@ -350,12 +564,9 @@ TileMap::draw(DrawingContext& context)
 
   for(pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
     for(pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*m_width + tx;
-      assert (index >= 0);
-      assert (index < (m_width * m_height));
-
-      if (m_tiles[index] == 0) continue;
-      const Tile& tile = m_tileset->get(m_tiles[index]);
+      const uint32_t id = m_tiles.get(tx, ty);
+      if (id == 0) continue;
+      const Tile& tile = m_tileset->get(id);
 
       const SurfacePtr& surface = tile.get_current_surface();
 
@@ -416,8 +627,7 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   m_width  = newwidth;
   m_height = newheight;
 
-  m_tiles.resize(newt.size());
-  m_tiles = newt;
+  set_tiles(m_width, m_height, newt);
 
   if (new_z_pos > (LAYER_GUI - 100))
     m_z_pos = LAYER_GUI - 100;
@@ -427,7 +637,7 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   update_effective_solid ();
 
   // make sure all tiles are loaded
-  for(const auto& tile : m_tiles)
+  for(const auto& tile : newt)
     m_tileset->get(tile);
 }
 
@@ -435,27 +645,29 @@ void
 TileMap::resize(int new_width, int new_height, int fill_id,
                 int xoffset, int yoffset)
 {
+  std::vector<uint32_t> tiles = m_tiles.get_all();
+
   if(new_width < m_width) {
     // remap tiles for new width
     for(int y = 0; y < m_height && y < new_height; ++y) {
       for(int x = 0; x < new_width; ++x) {
-        m_tiles[y * new_width + x] = m_tiles[y * m_width + x];
+        tiles[y * new_width + x] = tiles[y * m_width + x];
       }
     }
   }
 
-  m_tiles.resize(new_width * new_height, fill_id);
+  tiles.resize(new_width * new_height, fill_id);
 
   if(new_width > m_width) {
     // remap tiles
     for(int y = std::min(m_height, new_height)-1; y >= 0; --y) {
       for(int x = new_width-1; x >= 0; --x) {
         if(x >= m_width) {
-          m_tiles[y * new_width + x] = fill_id;
+          tiles[y * new_width + x] = fill_id;
           continue;
         }
 
-        m_tiles[y * new_width + x] = m_tiles[y * m_width + x];
+        tiles[y * new_width + x] = tiles[y * m_width + x];
       }
     }
   }
@@ -471,13 +683,15 @@ TileMap::resize(int new_width, int new_height, int fill_id,
         int X = (xoffset < 0) ? x : (m_width - x - 1);
         if (Y - yoffset < 0 || Y - yoffset >= m_height ||
             X - xoffset < 0 || X - xoffset >= m_width) {
-          m_tiles[Y * new_width + X] = fill_id;
+          tiles[Y * new_width + X] = fill_id;
         } else {
-          m_tiles[Y * new_width + X] = m_tiles[(Y - yoffset) * m_width + X - xoffset];
+          tiles[Y * new_width + X] = tiles[(Y - yoffset) * m_width + X - xoffset];
         }
       }
     }
   }
+
+  set_tiles(m_width, m_height, tiles);
 }
 
 void TileMap::resize(const Size& newsize, const Size& resize_offset) {
@@ -512,7 +726,7 @@ TileMap::get_tile_id(int x, int y) const
     return 0;
   }
 
-  return m_tiles[y*m_width + x];
+  return m_tiles.get(x, y);
 }
 
 const Tile&
@@ -540,7 +754,8 @@ void
 TileMap::change(int x, int y, uint32_t newtile)
 {
   assert(x >= 0 && x < m_width && y >= 0 && y < m_height);
-  m_tiles[y*m_width + x] = newtile;
+  record_tile_change(false, static_cast<uint32_t>(y * m_width + x), m_tiles.get_index_at(x, y));
+  m_tiles.set(x, y, newtile);
 }
 
 void
@@ -553,14 +768,32 @@ TileMap::change_at(const Vector& pos, uint32_t newtile)
 void
 TileMap::change_all(uint32_t oldtile, uint32_t newtile)
 {
-  for (int x = 0; x < get_width(); x++) {
-    for (int y = 0; y < get_height(); y++) {
-      if (get_tile_id(x,y) != oldtile)
-        continue;
+  const std::vector<uint32_t> old_palette = g_debug.record_snapshots ? m_tiles.get_palette() : std::vector<uint32_t>();
+  m_tiles.transform([oldtile, newtile](uint32_t id) {
+    return id == oldtile ? newtile : id;
+  });
+  record_palette_changes(old_palette);
+}
 
-      change(x,y,newtile);
+void
+TileMap::change_all(const std::vector<std::pair<uint32_t, uint32_t> >& replacements)
+{
+  if (replacements.empty())
+    return;
+
+  // transform() only visits the palette, so applying the pairs in
+  // order to each entry is cheap, and chains like a->b, b->c behave
+  // as with separate calls
+  const std::vector<uint32_t> old_palette = g_debug.record_snapshots ? m_tiles.get_palette() : std::vector<uint32_t>();
+  m_tiles.transform([&replacements](uint32_t id) {
+    for(const auto& replacement : replacements) {
+      if (id == replacement.first) {
+        id = replacement.second;
+      }
     }
-  }
+    return id;
+  });
+  record_palette_changes(old_palette);
 }
 
 void
@@ -602,6 +835,7 @@ TileMap::move_by(const Vector& shift)
   }
   path->move_by(shift);
   m_offset += shift;
+  m_previous_offset += shift;
 }
 
 /*
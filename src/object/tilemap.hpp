@@ -18,6 +18,10 @@
 #define HEADER_SUPERTUX_OBJECT_TILEMAP_HPP
 
 #include <algorithm>
+#include <deque>
+#include <stdint.h>
+#include <utility>
+#include <vector>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -27,6 +31,8 @@
 #include "scripting/exposed_object.hpp"
 #include "scripting/tilemap.hpp"
 #include "supertux/game_object.hpp"
+#include "supertux/timer.hpp"
+#include "util/paged_tiles.hpp"
 #include "video/color.hpp"
 #include "video/flip.hpp"
 #include "video/drawing_target.hpp"
@@ -41,12 +47,23 @@ class TileMap final :
   public ExposedObject<TileMap, scripting::TileMap>,
   public PathObject
 {
+public:
+  /** Save the tiles run-length encoded as (tiles-rle ...) instead of
+      as a list of ids, chosen in the editor */
+  static bool s_compact_tiles;
+
+  /** Tilemaps with at least this many tiles keep only the pages
+      around the active region unpacked */
+  static const int PAGED_TILE_COUNT = 256 * 256;
+
 public:
   TileMap(const TileSet *tileset);
   TileMap(const TileSet *tileset, const ReaderMapping& reader);
   virtual ~TileMap();
 
   virtual void save(Writer& writer) override;
+  virtual void backup(SnapshotWriter& writer) const override;
+  virtual void restore(SnapshotReader& reader) override;
   virtual std::string get_display_name() const override {
     return _("Tile map");
   }
@@ -56,6 +73,10 @@ public:
   virtual void update(float elapsed_time) override;
   virtual void draw(DrawingContext& context) override;
 
+  /** Draws the tilemap at \a alpha of the way from its offset before
+      the last update to the current one */
+  void draw(DrawingContext& context, float alpha);
+
   /** Move tilemap until at given node, then stop */
   void goto_node(int node_no);
 
@@ -80,6 +101,10 @@ public:
 
   Vector get_offset() const { return m_offset; }
 
+  /** Returns the offset at \a alpha of the way from the offset before
+      the last update to the current one, jumps aren't interpolated */
+  Vector get_interpolated_offset(float alpha) const;
+
   void move_by(const Vector& pos);
 
   /** Get the movement of this tilemap. The collision detection code
@@ -137,6 +162,10 @@ public:
   /** changes all tiles with the given ID */
   void change_all(uint32_t oldtile, uint32_t newtile);
 
+  /** Same result as calling change_all() for each (old, new) pair in
+      order, but visits each palette entry only once */
+  void change_all(const std::vector<std::pair<uint32_t, uint32_t> >& replacements);
+
   void set_flip(Flip flip)
   {
     m_flip = flip;
@@ -176,6 +205,22 @@ public:
 
 private:
   void update_effective_solid();
+  void set_tiles(int width, int height, const std::vector<uint32_t>& tiles);
+
+  /** Packs the pages of a large tilemap that are far from the camera */
+  void pack_unused_pages();
+
+  /** Journals a change of the tiles while snapshots are recorded, see
+      TileChange */
+  void record_tile_change(bool palette, uint32_t pos, uint32_t old_value);
+  void record_palette_changes(const std::vector<uint32_t>& old_palette);
+
+  /** Makes the journaled changes unreachable, for when the tiles are
+      replaced as a whole */
+  void forget_tile_changes();
+
+  /** Undoes journaled changes until the tiles are at \a revision */
+  void undo_tile_changes(uint64_t revision);
   void float_channel(float target, float &current, float remaining_time, float elapsed_time);
 
 public:
@@ -184,8 +229,25 @@ public:
 private:
   const TileSet* m_tileset;
 
-  typedef std::vector<uint32_t> Tiles;
-  Tiles m_tiles;
+  PagedTiles m_tiles;
+  bool m_paged;
+  Timer m_page_timer;
+
+  /** A change of a tile's palette index, or with palette set, of the
+      id of palette entry pos. Snapshots only store how many changes
+      were made, restoring one undoes the newer changes. */
+  struct TileChange
+  {
+    bool palette;
+    uint32_t pos;
+    uint32_t old_value;
+  };
+
+  std::deque<TileChange> m_tile_changes;
+
+  /** changes dropped from the front of m_tile_changes, the revision
+      of the tiles is this plus m_tile_changes.size() */
+  uint64_t m_tile_changes_base;
 
   /* read solid: In *general*, is this a solid layer? effective solid:
      is the layer *currently* solid? A generally solid layer may be
@@ -200,6 +262,7 @@ private:
   int m_z_pos;
   Vector m_offset;
   Vector m_movement; /**< The movement that happened last frame */
+  Vector m_previous_offset; /**< offset before the last update, used for interpolation */
 
   Flip m_flip;
   float m_alpha; /**< requested tilemap opacity */
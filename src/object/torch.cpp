@@ -53,7 +53,10 @@ Torch::draw(DrawingContext& context)
   {
     m_flame->draw(context.color(), get_pos(), LAYER_TILES - 1);
 
-    m_flame_light->draw(context.light(), get_pos(), 0);
+    if (!is_light_baked())
+    {
+      draw_light(context.light());
+    }
   }
 
   m_torch->draw(context.color(), get_pos(), LAYER_TILES - 1);
@@ -64,6 +67,21 @@ Torch::draw(DrawingContext& context)
   }
 }
 
+Rectf
+Torch::get_light_bbox() const
+{
+  return get_sprite_light_bbox(*m_flame_light, get_pos());
+}
+
+void
+Torch::draw_light(Canvas& canvas)
+{
+  if (m_burning)
+  {
+    m_flame_light->draw(canvas, get_pos(), 0);
+  }
+}
+
 void
 Torch::update(float)
 {
@@ -76,6 +94,7 @@ Torch::collision(GameObject& other, const CollisionHit& )
   if(player != nullptr && !m_burning)
   {
     m_burning = true;
+    invalidate_light();
   }
   return ABORT_MOVE;
 }
@@ -107,6 +126,7 @@ void
 Torch::set_burning(bool burning_)
 {
   m_burning = burning_;
+  invalidate_light();
 }
 
 /* EOF */
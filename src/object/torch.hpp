@@ -18,6 +18,7 @@
 #ifndef HEADER_SUPERTUX_OBJECT_TORCH_HPP
 #define HEADER_SUPERTUX_OBJECT_TORCH_HPP
 
+#include "object/static_light_source.hpp"
 #include "scripting/exposed_object.hpp"
 #include "scripting/torch.hpp"
 #include "sprite/sprite_ptr.hpp"
@@ -26,7 +27,8 @@
 class ReaderMapping;
 
 class Torch final : public MovingObject,
-              public ExposedObject<Torch, scripting::Torch>
+              public ExposedObject<Torch, scripting::Torch>,
+              public StaticLightSource
 {
 public:
   Torch(const ReaderMapping& reader);
@@ -36,6 +38,10 @@ public:
 
   HitResponse collision(GameObject& other, const CollisionHit& ) override;
 
+  virtual bool is_light_static() const override { return true; }
+  virtual Rectf get_light_bbox() const override;
+  virtual void draw_light(Canvas& canvas) override;
+
   /**
    * @name Scriptable Methods
    * @{
@@ -0,0 +1,39 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "physfs/physfs_cache_file.hpp"
+
+bool
+PhysFSCacheFile::stat_source(const std::string& filename, PHYSFS_Stat& statbuf)
+{
+  return PHYSFS_stat(filename.c_str(), &statbuf) != 0 &&
+         statbuf.filetype == PHYSFS_FILETYPE_REGULAR;
+}
+
+PHYSFSFilePtr
+PhysFSCacheFile::open_read(const std::string& filename)
+{
+  return PHYSFSFilePtr(PHYSFS_openRead(filename.c_str()), PHYSFS_close);
+}
+
+PHYSFSFilePtr
+PhysFSCacheFile::open_write(const std::string& filename)
+{
+  return PHYSFSFilePtr(PHYSFS_openWrite(filename.c_str()), PHYSFS_close);
+}
+
+/* EOF */
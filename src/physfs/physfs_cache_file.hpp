@@ -0,0 +1,46 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_PHYSFS_PHYSFS_CACHE_FILE_HPP
+#define HEADER_SUPERTUX_PHYSFS_PHYSFS_CACHE_FILE_HPP
+
+#include <physfs.h>
+#include <memory>
+#include <string>
+
+using PHYSFSFilePtr = std::unique_ptr<PHYSFS_File, int(*)(PHYSFS_File*)>;
+
+/** Helpers for the binary caches in the user directory (decoded
+    images, tilesets, sprite specs). A cache file is only ever read
+    back on the machine that wrote it, so its contents are stored in
+    native byte order, and each entry remembers the modification time
+    and size of the file it was made from. */
+class PhysFSCacheFile final
+{
+public:
+  /** Stats the file a cache entry is made from, returns false unless
+      it is a regular file */
+  static bool stat_source(const std::string& filename, PHYSFS_Stat& statbuf);
+
+  /** The returned pointer is empty when the file can't be opened */
+  static PHYSFSFilePtr open_read(const std::string& filename);
+  static PHYSFSFilePtr open_write(const std::string& filename);
+};
+
+#endif
+
+/* EOF */
@@ -29,6 +29,7 @@
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_loading_screen.hpp"
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/shrinkfade.hpp"
@@ -148,7 +149,7 @@ void load_level(const std::string& filename)
   }
   else
   {
-    ScreenManager::current()->push_screen(std::make_unique<GameSession>(filename, GameSession::current()->get_savegame()));
+    ScreenManager::current()->push_screen(std::make_unique<LevelLoadingScreen>(filename, GameSession::current()->get_savegame()));
   }
 }
 
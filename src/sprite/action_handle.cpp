@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "sprite/action_handle.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+struct ActionNames
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, int> ids;
+
+  /** a deque, so that get_name() references stay valid */
+  std::deque<std::string> names;
+};
+
+ActionNames& get_action_names()
+{
+  static ActionNames action_names;
+  return action_names;
+}
+
+} // namespace
+
+ActionHandle
+ActionHandle::from_name(const std::string& name)
+{
+  ActionNames& action_names = get_action_names();
+  std::lock_guard<std::mutex> lock(action_names.mutex);
+
+  auto it = action_names.ids.find(name);
+  if (it != action_names.ids.end())
+    return ActionHandle(it->second);
+
+  const int id = static_cast<int>(action_names.names.size());
+  action_names.names.push_back(name);
+  action_names.ids[name] = id;
+  return ActionHandle(id);
+}
+
+const std::string&
+ActionHandle::get_name() const
+{
+  static const std::string invalid;
+
+  ActionNames& action_names = get_action_names();
+  std::lock_guard<std::mutex> lock(action_names.mutex);
+  if (m_id < 0 || m_id >= static_cast<int>(action_names.names.size()))
+    return invalid;
+  return action_names.names[m_id];
+}
+
+/* EOF */
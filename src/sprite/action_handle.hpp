@@ -0,0 +1,54 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SPRITE_ACTION_HANDLE_HPP
+#define HEADER_SUPERTUX_SPRITE_ACTION_HANDLE_HPP
+
+#include <string>
+
+/** A sprite action name interned into a small integer. The same name
+    gives the same handle for every sprite, so a handle can be looked
+    up once, e.g. in a constructor or in a static, and then be used
+    with Sprite::set_action() without building or comparing strings.
+    Handles are only valid within one run of the game. */
+class ActionHandle final
+{
+public:
+  /** Interns \a name, this is thread-safe */
+  static ActionHandle from_name(const std::string& name);
+
+public:
+  ActionHandle() : m_id(-1) {}
+  explicit ActionHandle(int id) : m_id(id) {}
+
+  bool is_valid() const { return m_id >= 0; }
+  int get_id() const { return m_id; }
+
+  /** Returns the name the handle was interned from */
+  const std::string& get_name() const;
+
+  bool operator==(const ActionHandle& other) const { return m_id == other.m_id; }
+  bool operator!=(const ActionHandle& other) const { return m_id != other.m_id; }
+  bool operator<(const ActionHandle& other) const { return m_id < other.m_id; }
+
+private:
+  int m_id;
+};
+
+#endif
+
+/* EOF */
@@ -21,6 +21,7 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "video/surface.hpp"
+#include "video/texture_manager.hpp"
 
 Sprite::Sprite(SpriteData& newdata) :
   m_data(newdata),
@@ -31,10 +32,8 @@ Sprite::Sprite(SpriteData& newdata) :
   m_angle(0.0f),
   m_color(1.0f, 1.0f, 1.0f, 1.0f),
   m_blend(),
-  m_action(m_data.get_action("normal"))
+  m_action(m_data.get_default_action())
 {
-  if(!m_action)
-    m_action = m_data.actions.begin()->second.get();
   m_last_ticks = g_game_time;
 }
 
@@ -69,6 +68,27 @@ Sprite::set_action(const std::string& name, int loops)
     return;
   }
 
+  switch_action(newaction, loops);
+}
+
+void
+Sprite::set_action(ActionHandle handle, int loops)
+{
+  if(m_action && m_action->handle == handle)
+    return;
+
+  const SpriteData::Action* newaction = m_data.get_action(handle);
+  if(!newaction) {
+    log_debug << "Action '" << handle.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  switch_action(newaction, loops);
+}
+
+void
+Sprite::switch_action(const SpriteData::Action* newaction, int loops)
+{
   m_action = newaction;
   // If the new action has a loops property,
   // we prefer that over the parameter.
@@ -89,6 +109,27 @@ Sprite::set_action_continued(const std::string& name)
     return;
   }
 
+  switch_action_continued(newaction);
+}
+
+void
+Sprite::set_action_continued(ActionHandle handle)
+{
+  if(m_action && m_action->handle == handle)
+    return;
+
+  const SpriteData::Action* newaction = m_data.get_action(handle);
+  if(!newaction) {
+    log_debug << "Action '" << handle.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  switch_action_continued(newaction);
+}
+
+void
+Sprite::switch_action_continued(const SpriteData::Action* newaction)
+{
   m_action = newaction;
   update();
 }
@@ -151,6 +192,19 @@ Sprite::draw(Canvas& canvas, const Vector& pos, int layer,
   context.pop_transform();
 }
 
+void
+Sprite::prefetch() const
+{
+  for(const auto& surface : m_action->surfaces)
+  {
+    TextureManager::current()->prefetch(*surface->get_texture());
+    if (surface->get_displacement_texture())
+    {
+      TextureManager::current()->prefetch(*surface->get_displacement_texture());
+    }
+  }
+}
+
 int
 Sprite::get_width() const
 {
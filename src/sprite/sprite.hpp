@@ -24,6 +24,12 @@
 
 class Sprite final
 {
+public:
+  /** Returns the handle for the action \a name, which works with
+      every sprite, see ActionHandle */
+  static ActionHandle get_action_handle(const std::string& name)
+  { return ActionHandle::from_name(name); }
+
 public:
   Sprite(SpriteData& data);
 
@@ -35,9 +41,11 @@ public:
 
   /** Set action (or state) */
   void set_action(const std::string& name, int loops = -1);
+  void set_action(ActionHandle handle, int loops = -1);
 
   /** Set action (or state), but keep current frame number, loop counter, etc. */
   void set_action_continued(const std::string& name);
+  void set_action_continued(ActionHandle handle);
 
   /** Set number of animation cycles until animation stops */
   void set_animation_loops(int loops = -1)
@@ -58,6 +66,9 @@ public:
   /** Get current action name */
   const std::string& get_action() const
   { return m_action->name; }
+  /** Get current action handle */
+  ActionHandle get_current_action() const
+  { return m_action->handle; }
 
   int get_width() const;
   int get_height() const;
@@ -87,13 +98,24 @@ public:
 
   Blend get_blend() const;
 
+  /** Pages the textures of the current action back in, in case they
+      got evicted */
+  void prefetch() const;
+
   bool has_action (const std::string& name) const
   {
     return (m_data.get_action(name) != nullptr);
   }
 
+  bool has_action(ActionHandle handle) const
+  {
+    return (m_data.get_action(handle) != nullptr);
+  }
+
 private:
   void update();
+  void switch_action(const SpriteData::Action* newaction, int loops);
+  void switch_action_continued(const SpriteData::Action* newaction);
 
   SpriteData& m_data;
 
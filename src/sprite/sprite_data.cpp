@@ -26,10 +26,25 @@
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/reader_object.hpp"
+#include "util/string_util.hpp"
 #include "video/surface.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+TexturePtr load_texture(const boost::optional<SpriteData::TextureSpec>& spec)
+{
+  if (!spec)
+    return {};
+
+  return TextureManager::current()->get(spec->file, spec->rect, spec->sampler);
+}
+
+} // namespace
 
 SpriteData::Action::Action() :
   name(),
+  handle(),
   x_offset(0),
   y_offset(0),
   hitbox_w(0),
@@ -42,31 +57,129 @@ SpriteData::Action::Action() :
 {
 }
 
-SpriteData::SpriteData(const ReaderMapping& lisp) :
-  actions(),
-  name()
+SpriteData::TextureSpec::TextureSpec() :
+  file(),
+  rect(),
+  sampler()
+{
+}
+
+SpriteData::SurfaceSpec::SurfaceSpec() :
+  diffuse(),
+  displacement(),
+  flip(NO_FLIP)
+{
+}
+
+SpriteData::ActionSpec::ActionSpec() :
+  name(),
+  x_offset(0),
+  y_offset(0),
+  hitbox_w(0),
+  hitbox_h(0),
+  z_order(0),
+  fps(10),
+  loops(-1),
+  has_custom_loops(false),
+  mirror_action(),
+  images(),
+  surfaces()
+{
+}
+
+SpriteData::Spec::Spec() :
+  filename(),
+  name(),
+  actions()
 {
+}
+
+SpriteData::Spec
+SpriteData::parse(const ReaderMapping& lisp, const std::string& filename)
+{
+  Spec spec;
+  spec.filename = filename;
+
   auto iter = lisp.get_iter();
   while(iter.next()) {
     if(iter.get_key() == "name") {
-      iter.get(name);
+      iter.get(spec.name);
     } else if(iter.get_key() == "action") {
-      parse_action(iter.as_mapping());
+      spec.actions.push_back(parse_action(iter.as_mapping(), spec));
     } else {
       log_warning << "Unknown sprite field: " << iter.get_key() << std::endl;
     }
   }
-  if(actions.empty())
+  if(spec.actions.empty())
     throw std::runtime_error("Error: Sprite without actions.");
+
+  return spec;
+}
+
+SpriteData::SpriteData(const Spec& spec) :
+  actions(),
+  name(spec.name),
+  action_names(),
+  action_handles(),
+  default_action(nullptr)
+{
+  // the actions are loaded one after another, but their images can
+  // be decoded in parallel
+  preload_images(spec);
+
+  for(const auto& action : spec.actions) {
+    load_action(action);
+  }
+
+  index_actions();
 }
 
 void
-SpriteData::parse_action(const ReaderMapping& lisp)
+SpriteData::index_actions()
 {
-  auto action = std::make_unique<Action>();
+  std::vector<std::pair<std::string, const Action*> > names;
+  for(const auto& action : actions) {
+    names.emplace_back(action->name, action.get());
+    action_handles.emplace_back(action->handle.get_id(), action.get());
+  }
+  action_names.build(names);
+  std::sort(action_handles.begin(), action_handles.end());
+
+  default_action = get_action("normal");
+  if(!default_action) {
+    default_action = std::min_element(actions.begin(), actions.end(),
+                                      [](const std::unique_ptr<Action>& lhs, const std::unique_ptr<Action>& rhs) {
+                                        return lhs->name < rhs->name;
+                                      })->get();
+  }
+}
+
+void
+SpriteData::preload_images(const Spec& spec)
+{
+  for(const auto& action : spec.actions) {
+    for(const auto& image : action.images) {
+      if (!StringUtil::has_suffix(image, ".surface")) {
+        TextureManager::current()->preload(image);
+      }
+    }
+    for(const auto& surface : action.surfaces) {
+      for(const auto* texture : { &surface.diffuse, &surface.displacement }) {
+        if (*texture) {
+          TextureManager::current()->preload((*texture)->file);
+        }
+      }
+    }
+  }
+}
+
+SpriteData::ActionSpec
+SpriteData::parse_action(const ReaderMapping& lisp, const Spec& spec)
+{
+  ActionSpec action;
 
-  if(!lisp.get("name", action->name)) {
-    if(!actions.empty())
+  if(!lisp.get("name", action.name)) {
+    if(!spec.actions.empty())
       throw std::runtime_error(
         "If there are more than one action, they need names!");
   }
@@ -75,61 +188,45 @@ SpriteData::parse_action(const ReaderMapping& lisp)
   if (lisp.get("hitbox", hitbox)) {
     switch(hitbox.size()) {
       case 4:
-        action->hitbox_h = hitbox[3];
-        action->hitbox_w = hitbox[2];
+        action.hitbox_h = hitbox[3];
+        action.hitbox_w = hitbox[2];
 
         //fall-through
       case 2:
-        action->y_offset = hitbox[1];
-        action->x_offset = hitbox[0];
+        action.y_offset = hitbox[1];
+        action.x_offset = hitbox[0];
         break;
 
       default:
         throw std::runtime_error("hitbox should specify 2/4 coordinates");
     }
   }
-  lisp.get("z-order", action->z_order);
-  lisp.get("fps", action->fps);
-  if(lisp.get("loops", action->loops))
+  lisp.get("z-order", action.z_order);
+  lisp.get("fps", action.fps);
+  if(lisp.get("loops", action.loops))
   {
-    action->has_custom_loops = true;
+    action.has_custom_loops = true;
   }
 
-  std::string mirror_action;
-  if (lisp.get("mirror-action", mirror_action)) {
-    const auto act_tmp = get_action(mirror_action);
-    if(act_tmp == nullptr) {
+  if (lisp.get("mirror-action", action.mirror_action)) {
+    const bool found = std::any_of(spec.actions.begin(), spec.actions.end(),
+                                   [&action](const ActionSpec& other) {
+                                     return other.name == action.mirror_action;
+                                   });
+    if(!found) {
       std::ostringstream msg;
-      msg << "Could not mirror action. Action not found: \"" << mirror_action << "\"\n"
+      msg << "Could not mirror action. Action not found: \"" << action.mirror_action << "\"\n"
           << "Mirror actions must be defined after the real one!";
       throw std::runtime_error(msg.str());
-    } else {
-      float max_w = 0;
-      float max_h = 0;
-      for(const auto& surf : act_tmp->surfaces) {
-        auto surface = surf->clone(HORIZONTAL_FLIP);
-        max_w = std::max(max_w, static_cast<float>(surface->get_width()));
-        max_h = std::max(max_h, static_cast<float>(surface->get_height()));
-        action->surfaces.push_back(surface);
-      }
-      if (action->hitbox_w < 1) action->hitbox_w = max_w - action->x_offset;
-      if (action->hitbox_h < 1) action->hitbox_h = max_h - action->y_offset;
     }
   } else { // Load images
     boost::optional<ReaderCollection> surfaces_collection;
     std::vector<std::string> images;
     if (lisp.get("images", images))
     {
-      float max_w = 0;
-      float max_h = 0;
       for(const auto& image : images) {
-        auto surface = Surface::from_file(FileSystem::join(lisp.get_doc().get_directory(), image));
-        max_w = std::max(max_w, static_cast<float>(surface->get_width()));
-        max_h = std::max(max_h, static_cast<float>(surface->get_height()));
-        action->surfaces.push_back(surface);
+        action.images.push_back(FileSystem::join(lisp.get_doc().get_directory(), image));
       }
-      if (action->hitbox_w < 1) action->hitbox_w = max_w - action->x_offset;
-      if (action->hitbox_h < 1) action->hitbox_h = max_h - action->y_offset;
     }
     else if (lisp.get("surfaces", surfaces_collection))
     {
@@ -137,46 +234,145 @@ SpriteData::parse_action(const ReaderMapping& lisp)
       {
         if (i.get_name() == "surface")
         {
-          action->surfaces.push_back(Surface::from_reader(i.get_mapping()));
+          action.surfaces.push_back(parse_surface(i.get_mapping()));
         }
         else
         {
           std::stringstream msg;
-          msg << "Sprite '" << name << "' unknown tag in 'surfaces' << " << i.get_name();
+          msg << "Sprite '" << spec.name << "' unknown tag in 'surfaces' << " << i.get_name();
           throw std::runtime_error(msg.str());
         }
       }
-
-      // calculate hitbox
-      float max_w = 0;
-      float max_h = 0;
-      for (const auto& surface : action->surfaces)
-      {
-        max_w = std::max(max_w, static_cast<float>(surface->get_width()));
-        max_h = std::max(max_h, static_cast<float>(surface->get_height()));
-      }
-      if (action->hitbox_w < 1) action->hitbox_w = max_w - action->x_offset;
-      if (action->hitbox_h < 1) action->hitbox_h = max_h - action->y_offset;
     }
     else
     {
       std::stringstream msg;
-      msg << "Sprite '" << name << "' contains no images in action '"
-          << action->name << "'.";
+      msg << "Sprite '" << spec.name << "' contains no images in action '"
+          << action.name << "'.";
       throw std::runtime_error(msg.str());
     }
   }
-  actions[action->name] = std::move(action);
+
+  return action;
+}
+
+SpriteData::SurfaceSpec
+SpriteData::parse_surface(const ReaderMapping& mapping)
+{
+  SurfaceSpec surface;
+
+  boost::optional<ReaderMapping> texture_mapping;
+  if (mapping.get("diffuse-texture", texture_mapping))
+  {
+    surface.diffuse = TextureSpec();
+    TextureManager::parse_texture(*texture_mapping, surface.diffuse->file,
+                                  surface.diffuse->rect, surface.diffuse->sampler);
+  }
+
+  if (mapping.get("displacement-texture", texture_mapping))
+  {
+    surface.displacement = TextureSpec();
+    TextureManager::parse_texture(*texture_mapping, surface.displacement->file,
+                                  surface.displacement->rect, surface.displacement->sampler);
+  }
+
+  std::vector<bool> flip_v;
+  if (mapping.get("flip", flip_v) && flip_v.size() == 2)
+  {
+    surface.flip ^= flip_v[0] ? HORIZONTAL_FLIP : NO_FLIP;
+    surface.flip ^= flip_v[1] ? VERTICAL_FLIP : NO_FLIP;
+  }
+
+  return surface;
+}
+
+void
+SpriteData::load_action(const ActionSpec& spec)
+{
+  auto action = std::make_unique<Action>();
+  action->name = spec.name;
+  action->handle = ActionHandle::from_name(spec.name);
+  action->x_offset = spec.x_offset;
+  action->y_offset = spec.y_offset;
+  action->hitbox_w = spec.hitbox_w;
+  action->hitbox_h = spec.hitbox_h;
+  action->z_order = spec.z_order;
+  action->fps = spec.fps;
+  action->loops = spec.loops;
+  action->has_custom_loops = spec.has_custom_loops;
+
+  if (!spec.mirror_action.empty()) {
+    const auto act_tmp = find_action(spec.mirror_action);
+    if(act_tmp == nullptr) {
+      std::ostringstream msg;
+      msg << "Could not mirror action. Action not found: \"" << spec.mirror_action << "\"";
+      throw std::runtime_error(msg.str());
+    }
+    for(const auto& surf : act_tmp->surfaces) {
+      action->surfaces.push_back(surf->clone(HORIZONTAL_FLIP));
+    }
+  } else {
+    for(const auto& image : spec.images) {
+      action->surfaces.push_back(Surface::from_file(image));
+    }
+    for(const auto& surface : spec.surfaces) {
+      action->surfaces.push_back(Surface::from_textures(load_texture(surface.diffuse),
+                                                        load_texture(surface.displacement),
+                                                        surface.flip));
+    }
+  }
+
+  // calculate hitbox
+  float max_w = 0;
+  float max_h = 0;
+  for (const auto& surface : action->surfaces)
+  {
+    max_w = std::max(max_w, static_cast<float>(surface->get_width()));
+    max_h = std::max(max_h, static_cast<float>(surface->get_height()));
+  }
+  if (action->hitbox_w < 1) action->hitbox_w = max_w - action->x_offset;
+  if (action->hitbox_h < 1) action->hitbox_h = max_h - action->y_offset;
+
+  // a redefined action replaces the earlier one
+  for(auto& existing : actions) {
+    if(existing->name == action->name) {
+      existing = std::move(action);
+      return;
+    }
+  }
+  actions.push_back(std::move(action));
 }
 
 const SpriteData::Action*
 SpriteData::get_action(const std::string& act) const
 {
-  Actions::const_iterator i = actions.find(act);
-  if(i == actions.end()) {
+  const Action* const* action = action_names.find(act);
+  return action ? *action : nullptr;
+}
+
+const SpriteData::Action*
+SpriteData::get_action(ActionHandle handle) const
+{
+  // sprites have a handful of actions, so this stays in one cache line
+  auto it = std::lower_bound(action_handles.begin(), action_handles.end(), handle.get_id(),
+                             [](const std::pair<int, const Action*>& entry, int id) {
+                               return entry.first < id;
+                             });
+  if(it == action_handles.end() || it->first != handle.get_id()) {
     return nullptr;
   }
-  return i->second.get();
+  return it->second;
+}
+
+const SpriteData::Action*
+SpriteData::find_action(const std::string& act) const
+{
+  for(const auto& action : actions) {
+    if(action->name == act) {
+      return action.get();
+    }
+  }
+  return nullptr;
 }
 
 /* EOF */
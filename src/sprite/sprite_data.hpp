@@ -17,10 +17,17 @@
 #ifndef HEADER_SUPERTUX_SPRITE_SPRITE_DATA_HPP
 #define HEADER_SUPERTUX_SPRITE_SPRITE_DATA_HPP
 
-#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
+#include <boost/optional.hpp>
 
+#include "math/rect.hpp"
+#include "sprite/action_handle.hpp"
+#include "util/perfect_hash_map.hpp"
+#include "video/flip.hpp"
+#include "video/sampler.hpp"
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
@@ -28,8 +35,73 @@ class ReaderMapping;
 class SpriteData final
 {
 public:
-  /** cur has to be a pointer to data in the form of ((hitbox 5 10 0 0) ...) */
-  SpriteData(const ReaderMapping& cur);
+  /** A texture of a (surface ...) entry, see
+      TextureManager::parse_texture() */
+  struct TextureSpec
+  {
+    TextureSpec();
+
+    std::string file;
+    boost::optional<Rect> rect;
+    Sampler sampler;
+  };
+
+  /** A (surface ...) entry of an action */
+  struct SurfaceSpec
+  {
+    SurfaceSpec();
+
+    boost::optional<TextureSpec> diffuse;
+    boost::optional<TextureSpec> displacement;
+    Flip flip;
+  };
+
+  /** An action as written in the .sprite file, before any image got
+      loaded */
+  struct ActionSpec
+  {
+    ActionSpec();
+
+    std::string name;
+    float x_offset;
+    float y_offset;
+    float hitbox_w;
+    float hitbox_h;
+    int z_order;
+    float fps;
+    int loops;
+    bool has_custom_loops;
+
+    /** Name of the action that gets flipped, empty for none */
+    std::string mirror_action;
+
+    /** Image files, relative to the data directory */
+    std::vector<std::string> images;
+
+    /** (surface ...) entries */
+    std::vector<SurfaceSpec> surfaces;
+  };
+
+  /** The contents of a .sprite file. Reading it doesn't touch the
+      TextureManager, so it can happen on any thread. */
+  struct Spec
+  {
+    Spec();
+
+    /** The .sprite file, inline surfaces are relative to it */
+    std::string filename;
+    std::string name;
+    std::vector<ActionSpec> actions;
+  };
+
+  /** cur has to be a pointer to data in the form of ((hitbox 5 10 0 0) ...),
+      throws on malformed sprites */
+  static Spec parse(const ReaderMapping& cur, const std::string& filename);
+
+  SpriteData(const Spec& spec);
+
+  /** Queues the images of all actions for decoding in the background */
+  static void preload_images(const Spec& spec);
 
   const std::string& get_name() const
   {
@@ -44,6 +116,7 @@ private:
     Action();
 
     std::string name;
+    ActionHandle handle;
 
     /** Position correction */
     float x_offset;
@@ -71,14 +144,36 @@ private:
     std::vector<SurfacePtr> surfaces;
   };
 
-  typedef std::map <std::string, std::unique_ptr<Action> > Actions;
+  typedef std::vector<std::unique_ptr<Action> > Actions;
+
+  static ActionSpec parse_action(const ReaderMapping& lispreader, const Spec& spec);
+  static SurfaceSpec parse_surface(const ReaderMapping& mapping);
+
+  void load_action(const ActionSpec& spec);
+
+  /** Builds the lookup tables once all actions are parsed */
+  void index_actions();
 
-  void parse_action(const ReaderMapping& lispreader);
   /** Get an action */
   const Action* get_action(const std::string& act) const;
+  const Action* get_action(ActionHandle handle) const;
+
+  /** "normal", or the first action by name if there is none */
+  const Action* get_default_action() const
+  { return default_action; }
+
+  /** Linear lookup, used while the actions are still being loaded */
+  const Action* find_action(const std::string& act) const;
 
   Actions actions;
   std::string name;
+
+  PerfectHashMap<const Action*> action_names;
+
+  /** (handle id, action) sorted by id */
+  std::vector<std::pair<int, const Action*> > action_handles;
+
+  const Action* default_action;
 };
 
 #endif
@@ -0,0 +1,324 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "sprite/sprite_index.hpp"
+
+#include <string.h>
+#include <vector>
+
+#include "physfs/physfs_cache_file.hpp"
+#include "supertux/snapshot.hpp"
+#include "util/log.hpp"
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'S', 'I' };
+const uint32_t VERSION = 2;
+
+struct Header
+{
+  char magic[4];
+  uint32_t version;
+  uint32_t entry_count;
+};
+
+void write_strings(SnapshotWriter& writer, const std::vector<std::string>& strings)
+{
+  writer.write(static_cast<uint32_t>(strings.size()));
+  for(const auto& str : strings)
+  {
+    writer.write(str);
+  }
+}
+
+void read_strings(SnapshotReader& reader, std::vector<std::string>& strings)
+{
+  uint32_t count;
+  reader.read(count);
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    std::string str;
+    reader.read(str);
+    strings.push_back(str);
+  }
+}
+
+void write_texture(SnapshotWriter& writer, const boost::optional<SpriteData::TextureSpec>& texture)
+{
+  writer.write(static_cast<uint8_t>(texture ? 1 : 0));
+  if (!texture)
+    return;
+
+  writer.write(texture->file);
+  writer.write(static_cast<uint8_t>(texture->rect ? 1 : 0));
+  if (texture->rect)
+  {
+    writer.write(static_cast<int32_t>(texture->rect->left));
+    writer.write(static_cast<int32_t>(texture->rect->top));
+    writer.write(static_cast<int32_t>(texture->rect->right));
+    writer.write(static_cast<int32_t>(texture->rect->bottom));
+  }
+  writer.write(static_cast<uint32_t>(texture->sampler.get_filter()));
+  writer.write(static_cast<uint32_t>(texture->sampler.get_wrap_s()));
+  writer.write(static_cast<uint32_t>(texture->sampler.get_wrap_t()));
+  writer.write(texture->sampler.get_animate().x);
+  writer.write(texture->sampler.get_animate().y);
+}
+
+void read_texture(SnapshotReader& reader, boost::optional<SpriteData::TextureSpec>& texture)
+{
+  uint8_t has_texture;
+  reader.read(has_texture);
+  if (!has_texture)
+    return;
+
+  texture = SpriteData::TextureSpec();
+  reader.read(texture->file);
+
+  uint8_t has_rect;
+  reader.read(has_rect);
+  if (has_rect)
+  {
+    int32_t left, top, right, bottom;
+    reader.read(left);
+    reader.read(top);
+    reader.read(right);
+    reader.read(bottom);
+    texture->rect = Rect(left, top, right, bottom);
+  }
+
+  uint32_t filter, wrap_s, wrap_t;
+  Vector animate;
+  reader.read(filter);
+  reader.read(wrap_s);
+  reader.read(wrap_t);
+  reader.read(animate.x);
+  reader.read(animate.y);
+  texture->sampler = Sampler(filter, wrap_s, wrap_t, animate);
+}
+
+void write_surfaces(SnapshotWriter& writer, const std::vector<SpriteData::SurfaceSpec>& surfaces)
+{
+  writer.write(static_cast<uint32_t>(surfaces.size()));
+  for(const auto& surface : surfaces)
+  {
+    write_texture(writer, surface.diffuse);
+    write_texture(writer, surface.displacement);
+    writer.write(static_cast<uint32_t>(surface.flip));
+  }
+}
+
+void read_surfaces(SnapshotReader& reader, std::vector<SpriteData::SurfaceSpec>& surfaces)
+{
+  uint32_t count;
+  reader.read(count);
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    SpriteData::SurfaceSpec surface;
+    uint32_t flip;
+    read_texture(reader, surface.diffuse);
+    read_texture(reader, surface.displacement);
+    reader.read(flip);
+    surface.flip = flip;
+    surfaces.push_back(surface);
+  }
+}
+
+void write_spec(SnapshotWriter& writer, const SpriteData::Spec& spec)
+{
+  writer.write(spec.filename);
+  writer.write(spec.name);
+  writer.write(static_cast<uint32_t>(spec.actions.size()));
+  for(const auto& action : spec.actions)
+  {
+    writer.write(action.name);
+    writer.write(action.x_offset);
+    writer.write(action.y_offset);
+    writer.write(action.hitbox_w);
+    writer.write(action.hitbox_h);
+    writer.write(static_cast<int32_t>(action.z_order));
+    writer.write(action.fps);
+    writer.write(static_cast<int32_t>(action.loops));
+    writer.write(static_cast<uint8_t>(action.has_custom_loops ? 1 : 0));
+    writer.write(action.mirror_action);
+    write_strings(writer, action.images);
+    write_surfaces(writer, action.surfaces);
+  }
+}
+
+SpriteData::Spec read_spec(SnapshotReader& reader)
+{
+  SpriteData::Spec spec;
+  reader.read(spec.filename);
+  reader.read(spec.name);
+
+  uint32_t action_count;
+  reader.read(action_count);
+  for(uint32_t i = 0; i < action_count; ++i)
+  {
+    SpriteData::ActionSpec action;
+    int32_t z_order, loops;
+    uint8_t has_custom_loops;
+
+    reader.read(action.name);
+    reader.read(action.x_offset);
+    reader.read(action.y_offset);
+    reader.read(action.hitbox_w);
+    reader.read(action.hitbox_h);
+    reader.read(z_order);
+    reader.read(action.fps);
+    reader.read(loops);
+    reader.read(has_custom_loops);
+    reader.read(action.mirror_action);
+    read_strings(reader, action.images);
+    read_surfaces(reader, action.surfaces);
+
+    action.z_order = z_order;
+    action.loops = loops;
+    action.has_custom_loops = has_custom_loops != 0;
+    spec.actions.push_back(action);
+  }
+  return spec;
+}
+
+} // namespace
+
+SpriteIndex::SpriteIndex(const std::string& directory) :
+  m_filename(directory + "/sprites.idx"),
+  m_entries(),
+  m_modified(false)
+{
+  PHYSFS_mkdir(directory.c_str());
+  load();
+}
+
+void
+SpriteIndex::load()
+{
+  if (!PHYSFS_exists(m_filename.c_str()))
+    return;
+
+  PHYSFSFilePtr file = PhysFSCacheFile::open_read(m_filename);
+  if (!file)
+    return;
+
+  Header header;
+  if (PHYSFS_readBytes(file.get(), &header, sizeof(header)) != sizeof(header) ||
+      memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION)
+  {
+    return;
+  }
+
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file.get());
+  const PHYSFS_sint64 offset = PHYSFS_tell(file.get());
+  if (length < 0 || offset < 0 || length < offset)
+    return;
+
+  std::vector<uint8_t> data(static_cast<size_t>(length - offset));
+  if (PHYSFS_readBytes(file.get(), data.data(), data.size()) != static_cast<PHYSFS_sint64>(data.size()))
+    return;
+
+  std::unordered_map<std::string, Entry> entries;
+  try
+  {
+    SnapshotReader reader(data.data(), data.size());
+    for(uint32_t i = 0; i < header.entry_count; ++i)
+    {
+      std::string path;
+      Entry entry;
+      reader.read(path);
+      reader.read(entry.modtime);
+      reader.read(entry.filesize);
+      entry.spec = read_spec(reader);
+      entries[path] = std::move(entry);
+    }
+
+    if (!reader.eof())
+      return;
+  }
+  catch(const std::exception& err)
+  {
+    log_debug << "ignoring sprite index " << m_filename << ": " << err.what() << std::endl;
+    return;
+  }
+
+  m_entries = std::move(entries);
+}
+
+const SpriteData::Spec*
+SpriteIndex::find(const std::string& filename) const
+{
+  auto it = m_entries.find(filename);
+  if (it == m_entries.end())
+    return nullptr;
+
+  PHYSFS_Stat statbuf;
+  if (!PhysFSCacheFile::stat_source(filename, statbuf) ||
+      it->second.modtime != statbuf.modtime ||
+      it->second.filesize != statbuf.filesize)
+  {
+    return nullptr;
+  }
+
+  return &it->second.spec;
+}
+
+void
+SpriteIndex::add(const std::string& filename, const SpriteData::Spec& spec)
+{
+  PHYSFS_Stat statbuf;
+  if (!PhysFSCacheFile::stat_source(filename, statbuf))
+    return;
+
+  Entry entry;
+  entry.modtime = statbuf.modtime;
+  entry.filesize = statbuf.filesize;
+  entry.spec = spec;
+  m_entries[filename] = std::move(entry);
+  m_modified = true;
+}
+
+void
+SpriteIndex::save()
+{
+  if (!m_modified)
+    return;
+
+  SnapshotWriter writer;
+  for(const auto& it : m_entries)
+  {
+    writer.write(it.first);
+    writer.write(it.second.modtime);
+    writer.write(it.second.filesize);
+    write_spec(writer, it.second.spec);
+  }
+
+  PHYSFSFilePtr file = PhysFSCacheFile::open_write(m_filename);
+  if (!file)
+    return;
+
+  Header header;
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.entry_count = static_cast<uint32_t>(m_entries.size());
+
+  PHYSFS_writeBytes(file.get(), &header, sizeof(header));
+  PHYSFS_writeBytes(file.get(), writer.get_data().data(), writer.size());
+  m_modified = false;
+}
+
+/* EOF */
@@ -0,0 +1,69 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SPRITE_SPRITE_INDEX_HPP
+#define HEADER_SUPERTUX_SPRITE_SPRITE_INDEX_HPP
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+#include "sprite/sprite_data.hpp"
+
+/** Keeps the parsed .sprite files in a single binary file in the user
+    directory, so that the next start can skip their s-expressions.
+    Entries are keyed by path, file size and modification time of the
+    sprite. */
+class SpriteIndex final
+{
+public:
+  /** Reads the index from \a directory, a missing or broken index is
+      treated as empty */
+  SpriteIndex(const std::string& directory);
+
+  /** Returns the spec of \a filename, or nullptr when there is no
+      entry or the sprite changed since it got stored */
+  const SpriteData::Spec* find(const std::string& filename) const;
+
+  void add(const std::string& filename, const SpriteData::Spec& spec);
+
+  /** Writes the index back when entries got added, failures are
+      silently ignored, as the index is only an optimization */
+  void save();
+
+private:
+  struct Entry
+  {
+    int64_t modtime;
+    int64_t filesize;
+    SpriteData::Spec spec;
+  };
+
+  void load();
+
+private:
+  std::string m_filename;
+  std::unordered_map<std::string, Entry> m_entries;
+  bool m_modified;
+
+private:
+  SpriteIndex(const SpriteIndex&) = delete;
+  SpriteIndex& operator=(const SpriteIndex&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -18,14 +18,73 @@
 
 #include "sprite/sprite.hpp"
 #include "util/file_system.hpp"
+#include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+#include "util/thread_pool.hpp"
+#include "video/texture_manager.hpp"
 
 #include <sstream>
 
+namespace {
+
+bool is_sprite_file(const std::string& filename)
+{
+  return StringUtil::has_suffix(filename, ".sprite");
+}
+
+ReaderDocument load_sprite_document(const std::string& filename)
+{
+  try {
+    if(is_sprite_file(filename)) {
+      // Sprite file
+      return ReaderDocument::from_file(filename);
+    } else {
+      // Load image file directly
+      std::stringstream lisptext;
+      lisptext << "(supertux-sprite (action "
+      <<    "(name \"default\") "
+      <<    "(images \"" << FileSystem::basename(filename) << "\")))";
+      return ReaderDocument::from_stream(lisptext, filename);
+    }
+  } catch(const std::exception& e) {
+    std::ostringstream msg;
+    msg << "Parse error when trying to load sprite '" << filename
+    << "': " << e.what() << "\n";
+    throw std::runtime_error(msg.str());
+  }
+}
+
+/** Reads the spec of a sprite, safe to call from any thread */
+SpriteData::Spec read_spec(const std::string& filename)
+{
+  ReaderDocument doc = load_sprite_document(filename);
+
+  auto root = doc.get_root();
+
+  if(root.get_name() != "supertux-sprite") {
+    std::ostringstream msg;
+    msg << "'" << filename << "' is not a supertux-sprite file";
+    throw std::runtime_error(msg.str());
+  }
+
+  return SpriteData::parse(root.get_mapping(), filename);
+}
+
+} // namespace
+
 SpriteManager::SpriteManager() :
-  sprites()
+  sprites(),
+  index("cache/sprites"),
+  pending_specs(),
+  preloaded_specs()
+{
+}
+
+SpriteManager::~SpriteManager()
 {
+  index.save();
 }
 
 SpritePtr
@@ -48,42 +107,102 @@ SpriteManager::create(const std::string& name)
   return SpritePtr(new Sprite(*data));
 }
 
-SpriteData*
-SpriteManager::load(const std::string& filename)
+void
+SpriteManager::preload(const std::string& filename)
 {
-  ReaderDocument doc = [filename](){
+  if (sprites.find(filename) != sprites.end() ||
+      pending_specs.find(filename) != pending_specs.end())
+    return;
+
+  auto preloaded = preloaded_specs.find(filename);
+  if (preloaded != preloaded_specs.end()) {
+    SpriteData::preload_images(preloaded->second);
+    return;
+  }
+
+  if (const auto* spec = index.find(filename)) {
+    SpriteData::preload_images(*spec);
+    preloaded_specs[filename] = *spec;
+  } else {
+    pending_specs[filename] = TextureManager::current()->get_thread_pool().schedule([filename]{
+        return read_spec(filename);
+      });
+  }
+}
+
+bool
+SpriteManager::update_preloads()
+{
+  for(auto it = pending_specs.begin(); it != pending_specs.end();) {
+    if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      ++it;
+      continue;
+    }
+
     try {
-      if(filename.size() >= 7 && filename.compare(filename.size() - 7, 7, ".sprite") == 0) {
-        // Sprite file
-        return ReaderDocument::from_file(filename);
-      } else {
-        // Load image file directly
-        std::stringstream lisptext;
-        lisptext << "(supertux-sprite (action "
-        <<    "(name \"default\") "
-        <<    "(images \"" << FileSystem::basename(filename) << "\")))";
-        return ReaderDocument::from_stream(lisptext, filename);
-      }
+      auto spec = it->second.get();
+      add_to_index(it->first, spec);
+      SpriteData::preload_images(spec);
+      preloaded_specs[it->first] = std::move(spec);
     } catch(const std::exception& e) {
-      std::ostringstream msg;
-      msg << "Parse error when trying to load sprite '" << filename
-      << "': " << e.what() << "\n";
-      throw std::runtime_error(msg.str());
+      // reported once the sprite actually gets loaded
+      log_debug << e.what() << std::endl;
     }
-  }();
-
-  auto root = doc.get_root();
+    it = pending_specs.erase(it);
+  }
 
-  if(root.get_name() != "supertux-sprite") {
-    std::ostringstream msg;
-    msg << "'" << filename << "' is not a supertux-sprite file";
-    throw std::runtime_error(msg.str());
+  if (pending_specs.empty()) {
+    index.save();
+    return false;
   } else {
-    auto data = std::make_unique<SpriteData>(root.get_mapping());
-    sprites[filename] = std::move(data);
+    return true;
+  }
+}
 
-    return sprites[filename].get();
+SpriteData::Spec
+SpriteManager::get_spec(const std::string& filename)
+{
+  auto preloaded = preloaded_specs.find(filename);
+  if (preloaded != preloaded_specs.end()) {
+    auto spec = std::move(preloaded->second);
+    preloaded_specs.erase(preloaded);
+    return spec;
+  }
+
+  auto pending = pending_specs.find(filename);
+  if (pending != pending_specs.end()) {
+    auto future = std::move(pending->second);
+    pending_specs.erase(pending);
+    auto spec = future.get();
+    add_to_index(filename, spec);
+    return spec;
+  }
+
+  if (const auto* spec = index.find(filename)) {
+    return *spec;
+  }
+
+  auto spec = read_spec(filename);
+  add_to_index(filename, spec);
+  return spec;
+}
+
+void
+SpriteManager::add_to_index(const std::string& filename, const SpriteData::Spec& spec)
+{
+  // images used as sprites are cheaper to wrap than to look up
+  if (is_sprite_file(filename)) {
+    index.add(filename, spec);
   }
 }
 
+SpriteData*
+SpriteManager::load(const std::string& filename)
+{
+  auto data = std::make_unique<SpriteData>(get_spec(filename));
+  sprites[filename] = std::move(data);
+
+  return sprites[filename].get();
+}
+
 /* EOF */
@@ -17,29 +17,50 @@
 #ifndef HEADER_SUPERTUX_SPRITE_SPRITE_MANAGER_HPP
 #define HEADER_SUPERTUX_SPRITE_SPRITE_MANAGER_HPP
 
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
 
+#include "sprite/sprite_data.hpp"
+#include "sprite/sprite_index.hpp"
 #include "sprite/sprite_ptr.hpp"
 #include "util/currenton.hpp"
 
-class SpriteData;
-
 class SpriteManager final : public Currenton<SpriteManager>
 {
 private:
   typedef std::map<std::string, std::unique_ptr<SpriteData> > Sprites;
   Sprites sprites;
 
+  SpriteIndex index;
+
+  /** sprites that are being parsed on the TextureManager's threads */
+  std::map<std::string, std::future<SpriteData::Spec> > pending_specs;
+
+  /** parsed sprites whose images are being decoded */
+  std::map<std::string, SpriteData::Spec> preloaded_specs;
+
 public:
   SpriteManager();
+  ~SpriteManager();
 
   /** loads a sprite. */
   SpritePtr create(const std::string& filename);
 
+  /** starts parsing a sprite and decoding its images, for sprites
+      that will be needed soon; calling it again keeps the decoded
+      images around */
+  void preload(const std::string& filename);
+
+  /** Queues the images of the sprites that finished parsing, returns
+      true while parses are still running */
+  bool update_preloads();
+
 private:
   SpriteData* load(const std::string& filename);
+  SpriteData::Spec get_spec(const std::string& filename);
+  void add_to_index(const std::string& filename, const SpriteData::Spec& spec);
 };
 
 #endif
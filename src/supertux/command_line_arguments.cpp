@@ -16,12 +16,15 @@
 
 #include "supertux/command_line_arguments.hpp"
 
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <config.h>
+#include <fstream>
 #include <physfs.h>
 
 #include "supertux/gameconfig.hpp"
 #include "util/gettext.hpp"
+#include "util/reader_document.hpp"
 #include "version.h"
 
 CommandLineArguments::CommandLineArguments() :
@@ -49,7 +52,8 @@ CommandLineArguments::CommandLineArguments() :
   developer_mode(),
   christmas_mode(),
   repository_url(),
-  edit_level()
+  edit_level(),
+  compile_level()
 {
 }
 
@@ -66,6 +70,37 @@ CommandLineArguments::print_datadir() const
   PHYSFS_freeList(sp);
 }
 
+void
+CommandLineArguments::compile_level_file() const
+{
+  const std::string& filename = *compile_level;
+  const std::string compiled = ReaderDocument::get_compiled_filename(filename);
+
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  if (!in)
+  {
+    throw std::runtime_error("Couldn't open level file '" + filename + "'");
+  }
+  auto doc = ReaderDocument::from_stream(in, filename);
+
+  // PhysFS reports the same modification time and size for the file
+  // when the level gets loaded
+  const ReaderDocument::CompiledSource source = {
+    static_cast<int64_t>(boost::filesystem::last_write_time(filename)),
+    static_cast<int64_t>(boost::filesystem::file_size(filename))
+  };
+
+  std::ofstream out(compiled.c_str(), std::ios::binary);
+  doc.write_compiled(out, source);
+  out.close();
+  if (!out)
+  {
+    throw std::runtime_error("Couldn't write compiled level '" + compiled + "'");
+  }
+
+  std::cout << filename << " -> " << compiled << std::endl;
+}
+
 void
 CommandLineArguments::print_help(const char* arg0) const
 {
@@ -92,6 +127,7 @@ CommandLineArguments::print_help(const char* arg0) const
     << "\n"
     << _(     "Game Options:") << "\n"
     << _(     "  --edit-level                 Open given level in editor") << "\n"
+    << _(     "  --compile-level FILE         Compile a level to the binary .stlb format and quit") << "\n"
     << _(     "  --show-fps                   Display framerate in levels") << "\n"
     << _(     "  --no-show-fps                Do not display framerate in levels") << "\n"
     << _(     "  --show-pos                   Display player's current position") << "\n"
@@ -383,6 +419,18 @@ CommandLineArguments::parse_args(int argc, char** argv)
         edit_level = argv[++i];
       }
     }
+    else if (arg == "--compile-level")
+    {
+      if (i + 1 >= argc)
+      {
+        throw std::runtime_error("Need to specify a level for --compile-level");
+      }
+      else
+      {
+        m_action = COMPILE_LEVEL;
+        compile_level = argv[++i];
+      }
+    }
     else if (arg[0] != '-')
     {
       start_level = arg;
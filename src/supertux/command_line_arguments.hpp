@@ -35,7 +35,8 @@ public:
     NO_ACTION,
     PRINT_VERSION,
     PRINT_HELP,
-    PRINT_DATADIR
+    PRINT_DATADIR,
+    COMPILE_LEVEL
   };
 
 private:
@@ -79,6 +80,8 @@ public:
 
   boost::optional<std::string> edit_level;
 
+  boost::optional<std::string> compile_level;
+
   // boost::optional<std::string> locale;
 
 public:
@@ -93,6 +96,10 @@ public:
   void print_version() const;
   void print_datadir() const;
 
+  /** Writes the compiled version of the level given with
+      --compile-level next to it */
+  void compile_level_file() const;
+
   void merge_into(Config& config);
 
 private:
@@ -81,6 +81,7 @@ public:
   void toggle(); /**< display the console if hidden, hide otherwise */
 
   bool hasFocus() const; /**< true if characters should be sent to the console instead of their normal target */
+  bool is_visible() const { return m_height > 0; } /**< true if the console is (partially) shown */
 
 private:
   ConsoleBuffer& m_buffer;
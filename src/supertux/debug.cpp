@@ -24,6 +24,7 @@ Debug g_debug;
 Debug::Debug() :
   show_collision_rects(false),
   show_worldmap_path(false),
+  record_snapshots(false),
   m_use_bitmap_fonts(false),
   m_game_speed_multiplier(1.0f)
 {
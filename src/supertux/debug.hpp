@@ -35,6 +35,9 @@ public:
   /** Draw the path on the worldmap, including invisible paths */
   bool show_worldmap_path;
 
+  /** Keep a history of sector states to allow rewinding */
+  bool record_snapshots;
+
 private:
   /** Use old bitmap fonts instead of TTF */
   bool m_use_bitmap_fonts;
@@ -26,6 +26,8 @@
 class DrawingContext;
 class ObjectRemoveListener;
 class ReaderMapping;
+class SnapshotReader;
+class SnapshotWriter;
 class Writer;
 
 /**
@@ -105,6 +107,12 @@ public:
   /** continues all looping sounds */
   virtual void play_looping_sounds() {}
 
+  /** Stores the runtime state of the object for rewinding, restore()
+      has to read back exactly what backup() wrote. Objects that
+      don't override these are left untouched by a rewind. */
+  virtual void backup(SnapshotWriter& /*writer*/) const {}
+  virtual void restore(SnapshotReader& /*reader*/) {}
+
 private:
   void set_uid(const UID& uid) { m_uid = uid; }
 
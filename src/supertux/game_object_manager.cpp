@@ -20,7 +20,9 @@
 #include <algorithm>
 
 #include "object/tilemap.hpp"
+#include "supertux/moving_object.hpp"
 #include "supertux/sector.hpp"
+#include "video/drawing_context.hpp"
 
 bool GameObjectManager::s_draw_solids_only = false;
 
@@ -91,7 +93,7 @@ GameObjectManager::update(float delta)
 }
 
 void
-GameObjectManager::draw(DrawingContext& context)
+GameObjectManager::draw(DrawingContext& context, float alpha)
 {
   for(const auto& object : m_gameobjects)
   {
@@ -105,7 +107,27 @@ GameObjectManager::draw(DrawingContext& context)
         continue;
     }
 
-    object->draw(context);
+    auto tilemap = (alpha < 1.0f) ? dynamic_cast<TileMap*>(object.get()) : nullptr;
+    auto moving_object = (alpha < 1.0f) ? dynamic_cast<MovingObject*>(object.get()) : nullptr;
+    if (tilemap)
+    {
+      tilemap->draw(context, alpha);
+    }
+    else if (moving_object)
+    {
+      // objects draw themselves at their current position, so shift
+      // the whole context to get them to the interpolated one
+      const Vector offset = moving_object->get_interpolated_pos(alpha) - moving_object->get_pos();
+
+      context.push_transform();
+      context.set_translation(context.get_translation() - offset);
+      object->draw(context);
+      context.pop_transform();
+    }
+    else
+    {
+      object->draw(context);
+    }
   }
 }
 
@@ -53,7 +53,10 @@ public:
   }
 
   void update(float delta);
-  void draw(DrawingContext& context);
+
+  /** Draw all objects, MovingObjects and TileMaps are drawn at \a
+      alpha of the way from their previous to their current position */
+  void draw(DrawingContext& context, float alpha = 1.0f);
 
   const std::vector<GameObjectPtr>& get_objects() const;
 
@@ -85,7 +88,7 @@ public:
   T* get_object_by_uid(const UID& uid) const
   {
     auto it = m_objects_by_uid.find(uid);
-    if (it != m_objects_by_uid.end())
+    if (it == m_objects_by_uid.end())
     {
       return nullptr;
     }
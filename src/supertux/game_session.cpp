@@ -16,6 +16,8 @@
 
 #include "supertux/game_session.hpp"
 
+#include <chrono>
+
 #include "audio/sound_manager.hpp"
 #include "control/input_manager.hpp"
 #include "gui/menu_manager.hpp"
@@ -35,14 +37,17 @@
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "util/file_system.hpp"
+#include "util/reader_document.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
 #include "worldmap/worldmap.hpp"
 
-GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics) :
+GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics,
+                         std::unique_ptr<ReaderDocument> level_document) :
   GameSessionRecorder(),
   reset_button(false),
+  m_level_document(std::move(level_document)),
   m_level(),
   m_old_level(),
   m_statistics_backdrop(Surface::from_file("images/engine/menu/score-backdrop.png")),
@@ -74,6 +79,10 @@ GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Stat
     throw std::runtime_error ("Initializing the level failed.");
 }
 
+GameSession::~GameSession()
+{
+}
+
 void
 GameSession::reset_level()
 {
@@ -113,8 +122,17 @@ GameSession::restart_level(bool after_death)
   }
 
   try {
+    const auto start = std::chrono::steady_clock::now();
+
+    if (!m_level_document) {
+      m_level_document = std::make_unique<ReaderDocument>(LevelParser::load_document(m_levelfile));
+    }
+
     m_old_level = std::move(m_level);
-    m_level = LevelParser::from_file(m_levelfile);
+    m_level = LevelParser::from_document(*m_level_document, m_levelfile, g_config->lazy_sectors);
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    log_debug << "level " << m_levelfile << " built in " << elapsed.count() / 1000.0f << " ms" << std::endl;
 
     if(!m_reset_sector.empty()) {
       m_currentsector = m_level->get_sector(m_reset_sector);
@@ -196,6 +214,13 @@ GameSession::abort_level()
   SoundManager::current()->stop_sounds();
 }
 
+bool
+GameSession::needs_redraw() const
+{
+  // the paused game is frozen under the menu
+  return !m_game_pause;
+}
+
 bool
 GameSession::is_active() const
 {
@@ -421,6 +446,9 @@ GameSession::finish(bool win)
   }
 
   if(win) {
+    // sectors that were never entered still count for the totals
+    m_level->construct_deferred_sectors();
+
     if(WorldMap::current())
     {
       WorldMap::current()->finished_level(m_level.get());
@@ -481,6 +509,9 @@ GameSession::start_sequence(Sequence seq, const SequenceData* data)
   if (m_end_sequence)
     return;
 
+  // the statistics panel of the end sequence shows the level totals
+  m_level->construct_deferred_sectors();
+
   std::unique_ptr<EndSequence> end_sequence;
   if (seq == SEQ_ENDSEQUENCE) {
     if (m_currentsector->get_players()[0]->get_physic().get_velocity_x() < 0) {
@@ -33,6 +33,7 @@ class CodeController;
 class DrawingContext;
 class EndSequence;
 class Level;
+class ReaderDocument;
 class Sector;
 class Statistics;
 class Savegame;
@@ -45,10 +46,15 @@ class GameSession final : public Screen,
                           public Currenton<GameSession>
 {
 public:
-  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr);
+  /** \a level_document is the already loaded level file, it gets
+      loaded by the session when none is given */
+  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr,
+              std::unique_ptr<ReaderDocument> level_document = {});
+  ~GameSession();
 
   virtual void draw(Compositor& compositor) override;
   virtual void update(float frame_ratio) override;
+  virtual bool needs_redraw() const override;
   virtual void setup() override;
   virtual void leave() override;
 
@@ -106,6 +112,11 @@ private:
   void on_escape_press();
 
 private:
+  /** the level as it was loaded, restarts rebuild the level from it
+      instead of reading the file again, deferred sectors are built
+      from it too, so it has to outlive the levels */
+  std::unique_ptr<ReaderDocument> m_level_document;
+
   std::unique_ptr<Level> m_level;
   std::unique_ptr<Level> m_old_level;
   SurfacePtr m_statistics_backdrop;
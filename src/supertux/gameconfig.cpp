@@ -29,6 +29,11 @@ Config::Config() :
   window_size(1280, 800),
   aspect_size(0, 0), // auto detect
   magnification(0.0f),
+  lightmap_downscale(0), // auto detect
+  dynamic_resolution(false),
+  frame_interpolation(false),
+  texture_budget(256),
+  texture_cache(false),
   use_fullscreen(false),
   video(VideoSystem::VIDEO_AUTO),
   try_vsync(true),
@@ -54,6 +59,7 @@ Config::Config() :
   transitions_enabled(true),
   confirmation_dialog(false),
   pause_on_focusloss(true),
+  lazy_sectors(false),
   repository_url()
 {
 }
@@ -75,6 +81,7 @@ Config::load()
   config_lisp.get("developer", developer_mode);
   config_lisp.get("confirmation_dialog", confirmation_dialog);
   config_lisp.get("pause_on_focusloss", pause_on_focusloss);
+  config_lisp.get("lazy_sectors", lazy_sectors);
 
   if(is_christmas()) {
     if(!config_lisp.get("christmas", christmas_mode))
@@ -113,6 +120,23 @@ Config::load()
     config_video_lisp->get("aspect_height", aspect_size.height);
 
     config_video_lisp->get("magnification", magnification);
+
+    config_video_lisp->get("lightmap_downscale", lightmap_downscale);
+    if(lightmap_downscale < 0)
+    {
+      lightmap_downscale = 0;
+    }
+
+    config_video_lisp->get("dynamic_resolution", dynamic_resolution);
+    config_video_lisp->get("frame_interpolation", frame_interpolation);
+
+    config_video_lisp->get("texture_budget", texture_budget);
+    if(texture_budget < 0)
+    {
+      texture_budget = 0;
+    }
+
+    config_video_lisp->get("texture_cache", texture_cache);
   }
 
   boost::optional<ReaderMapping> config_audio_lisp;
@@ -178,6 +202,7 @@ Config::save()
   writer.write("developer", developer_mode);
   writer.write("confirmation_dialog", confirmation_dialog);
   writer.write("pause_on_focusloss", pause_on_focusloss);
+  writer.write("lazy_sectors", lazy_sectors);
   if(is_christmas()) {
     writer.write("christmas", christmas_mode);
   }
@@ -202,6 +227,12 @@ Config::save()
 
   writer.write("magnification", magnification);
 
+  writer.write("lightmap_downscale", lightmap_downscale);
+  writer.write("dynamic_resolution", dynamic_resolution);
+  writer.write("frame_interpolation", frame_interpolation);
+  writer.write("texture_budget", texture_budget);
+  writer.write("texture_cache", texture_cache);
+
   writer.end_list("video");
 
   writer.start_list("audio");
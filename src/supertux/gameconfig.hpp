@@ -51,6 +51,26 @@ public:
 
   float magnification;
 
+  /** factor by which the lightmap is rendered smaller than the
+      logical screen, 0 for auto */
+  int lightmap_downscale;
+
+  /** lower the resolution the level is rendered at when drawing
+      takes longer than the frame budget */
+  bool dynamic_resolution;
+
+  /** run the game logic at LOGICAL_FPS and interpolate positions for
+      the frames drawn in between, the framerate only limits drawing */
+  bool frame_interpolation;
+
+  /** video memory in MB that cached image textures may occupy before
+      unused ones get evicted, 0 for no limit */
+  int texture_budget;
+
+  /** keep decoded images in the user directory, so that they don't
+      have to be decoded again on the next start */
+  bool texture_cache;
+
   bool use_fullscreen;
   VideoSystem::Enum video;
   bool try_vsync;
@@ -97,6 +117,10 @@ public:
   bool confirmation_dialog;
   bool pause_on_focusloss;
 
+  /** construct the sectors of a level when they are first entered
+      instead of all of them when the level is loaded */
+  bool lazy_sectors;
+
   std::string repository_url;
 
   bool is_christmas() const {
@@ -22,5 +22,6 @@ std::unique_ptr<Config> g_config;
 
 float g_game_time = 0;
 float g_real_time = 0;
+float g_frame_alpha = 1.0f;
 
 /* EOF */
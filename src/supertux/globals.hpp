@@ -32,6 +32,11 @@ extern std::unique_ptr<Config> g_config;
 extern float g_game_time;
 extern float g_real_time;
 
+/** Fraction of a logic step that has passed since the last update,
+    used to interpolate positions when frame interpolation is on,
+    1.0 otherwise */
+extern float g_frame_alpha;
+
 #endif
 
 /* EOF */
@@ -20,13 +20,55 @@
 #include "object/bonus_block.hpp"
 #include "object/coin.hpp"
 #include "physfs/physfs_file_system.hpp"
+#include "supertux/globals.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/sector_parser.hpp"
 #include "trigger/secretarea_trigger.hpp"
 #include "util/file_system.hpp"
+#include "util/log.hpp"
 #include "util/writer.hpp"
 
 #include <physfs.h>
 
+namespace {
+
+/** seconds between renewing the preloads of a prewarmed sector, well
+    below the time unused preloads are kept at high frame rates */
+const float PREWARM_INTERVAL = 0.2f;
+
+int count_coins(const Sector& sector)
+{
+  int total_coins = 0;
+  for(const auto& o: sector.get_objects()) {
+    auto coin = dynamic_cast<Coin*>(o.get());
+    if(coin)
+    {
+      total_coins++;
+      continue;
+    }
+    auto block = dynamic_cast<BonusBlock*>(o.get());
+    if(block)
+    {
+      if (block->get_contents() == BonusBlock::CONTENT_COIN)
+      {
+        total_coins += block->get_hit_counter();
+        continue;
+      } else if (block->get_contents() == BonusBlock::CONTENT_RAIN ||
+                 block->get_contents() == BonusBlock::CONTENT_EXPLODE)
+      {
+        total_coins += 10;
+        continue;
+      }
+    }
+    auto goldbomb = dynamic_cast<GoldBomb*>(o.get());
+    if(goldbomb)
+      total_coins += 10;
+  }
+  return total_coins;
+}
+
+} // namespace
+
 Level* Level::s_current = nullptr;
 
 Level::Level() :
@@ -38,7 +80,8 @@ Level::Level() :
   m_sectors(),
   m_stats(),
   m_target_time(),
-  m_tileset("images/tiles.strf")
+  m_tileset("images/tiles.strf"),
+  m_deferred_sectors()
 {
   s_current = this;
 }
@@ -53,6 +96,8 @@ Level::save(const std::string& filepath, bool retry)
 {
   //FIXME: It tests for directory in supertux/data, but saves into .supertux2.
 
+  construct_deferred_sectors();
+
   try {
 
     { // make sure the level directory exists
@@ -134,17 +179,77 @@ Level::add_sector(std::unique_ptr<Sector> sector)
   }
 }
 
+void
+Level::add_deferred_sector(const std::string& name, const ReaderMapping& reader)
+{
+  if (get_sector(name) != nullptr || m_deferred_sectors.count(name)) {
+    throw std::runtime_error("Trying to add 2 sectors with same name");
+  } else {
+    m_deferred_sectors.emplace(name, DeferredSector{reader, -PREWARM_INTERVAL});
+  }
+}
+
 Sector*
-Level::get_sector(const std::string& name_) const
+Level::get_sector(const std::string& name_)
 {
   for(auto const& sector : m_sectors) {
     if(sector->get_name() == name_) {
       return sector.get();
     }
   }
+
+  auto it = m_deferred_sectors.find(name_);
+  if (it != m_deferred_sectors.end()) {
+    return construct_deferred_sector(it);
+  }
   return nullptr;
 }
 
+void
+Level::prewarm_sector(const std::string& name)
+{
+  auto it = m_deferred_sectors.find(name);
+  if (it != m_deferred_sectors.end() &&
+      g_real_time - it->second.prewarm_time >= PREWARM_INTERVAL) {
+    SectorParser::preload(it->second.reader);
+    it->second.prewarm_time = g_real_time;
+  }
+}
+
+void
+Level::construct_deferred_sectors()
+{
+  while (!m_deferred_sectors.empty()) {
+    construct_deferred_sector(m_deferred_sectors.begin());
+  }
+}
+
+Sector*
+Level::construct_deferred_sector(DeferredSectors::iterator it)
+{
+  // take it out first, so that a failing sector isn't tried again
+  const std::string name = it->first;
+  const DeferredSector deferred = it->second;
+  m_deferred_sectors.erase(it);
+
+  // the prewarm's preloads may have been dropped already, queueing
+  // the ones that are still around again is cheap
+  SectorParser::preload(deferred.reader);
+
+  auto sector = SectorParser::from_reader(*this, deferred.reader);
+  sector->set_name(name);
+  Sector* result = sector.get();
+  m_sectors.push_back(std::move(sector));
+
+  // the totals only covered the sectors that existed at load time
+  m_stats.m_total_coins += count_coins(*result);
+  m_stats.m_total_badguys += result->get_total_badguys();
+  m_stats.m_total_secrets += result->get_object_count<SecretAreaTrigger>();
+
+  log_debug << "constructed deferred sector '" << name << "'" << std::endl;
+  return result;
+}
+
 size_t
 Level::get_sector_count() const
 {
@@ -162,31 +267,7 @@ Level::get_total_coins() const
 {
   int total_coins = 0;
   for(auto const& sector : m_sectors) {
-    for(const auto& o: sector->get_objects()) {
-      auto coin = dynamic_cast<Coin*>(o.get());
-      if(coin)
-      {
-        total_coins++;
-        continue;
-      }
-      auto block = dynamic_cast<BonusBlock*>(o.get());
-      if(block)
-      {
-        if (block->get_contents() == BonusBlock::CONTENT_COIN)
-        {
-          total_coins += block->get_hit_counter();
-          continue;
-        } else if (block->get_contents() == BonusBlock::CONTENT_RAIN ||
-                   block->get_contents() == BonusBlock::CONTENT_EXPLODE)
-        {
-          total_coins += 10;
-          continue;
-        }
-      }
-      auto goldbomb = dynamic_cast<GoldBomb*>(o.get());
-      if(goldbomb)
-        total_coins += 10;
-    }
+    total_coins += count_coins(*sector);
   }
   return total_coins;
 }
@@ -17,9 +17,11 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_HPP
 #define HEADER_SUPERTUX_SUPERTUX_LEVEL_HPP
 
+#include <map>
+
 #include "supertux/statistics.hpp"
+#include "util/reader_mapping.hpp"
 
-class ReaderMapping;
 class Sector;
 
 /**
@@ -53,10 +55,30 @@ public:
   void save(const std::string& filename, bool retry = false);
 
   void add_sector(std::unique_ptr<Sector> sector);
+
+  /** Remembers a sector that gets constructed on the first
+      get_sector() call for its name, the document \a reader belongs
+      to has to outlive the level */
+  void add_deferred_sector(const std::string& name, const ReaderMapping& reader);
+
   const std::string& get_name() const { return m_name; }
   const std::string& get_author() const { return m_author; }
 
-  Sector* get_sector(const std::string& name) const;
+  /** returns the sector with the given name, constructing it first
+      if it was deferred */
+  Sector* get_sector(const std::string& name);
+
+  /** Starts decoding the images of a deferred sector, called every
+      frame while the player is close to an entrance of it; the
+      preloads get renewed every now and then so that they outlive a
+      player waiting at the door */
+  void prewarm_sector(const std::string& name);
+
+  /** Constructs the remaining deferred sectors, so that the
+      statistics cover the whole level */
+  void construct_deferred_sectors();
+
+  bool has_deferred_sectors() const { return !m_deferred_sectors.empty(); }
 
   size_t get_sector_count() const;
   Sector* get_sector(size_t num) const;
@@ -73,11 +95,26 @@ public:
 
   void reactivate();
 
+private:
+  struct DeferredSector
+  {
+    ReaderMapping reader;
+    /** g_real_time of the last prewarm_sector() */
+    float prewarm_time;
+  };
+
+  using DeferredSectors = std::map<std::string, DeferredSector>;
+
 private:
   static Level* s_current;
 
   void load_old_format(const ReaderMapping& reader);
 
+  Sector* construct_deferred_sector(DeferredSectors::iterator it);
+
+private:
+  DeferredSectors m_deferred_sectors;
+
 private:
   Level(const Level&);
   Level& operator=(const Level&);
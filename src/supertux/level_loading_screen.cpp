@@ -0,0 +1,189 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/level_loading_screen.hpp"
+
+#include "sprite/sprite_manager.hpp"
+#include "supertux/game_session.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "supertux/level_parser.hpp"
+#include "supertux/resources.hpp"
+#include "supertux/screen_fade.hpp"
+#include "supertux/screen_manager.hpp"
+#include "util/gettext.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/thread_pool.hpp"
+#include "video/compositor.hpp"
+#include "video/drawing_context.hpp"
+#include "video/layer.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+/** share of the progress bar that reading the file takes */
+const float PARSE_PROGRESS = 0.25f;
+
+float milliseconds_between(std::chrono::steady_clock::time_point start,
+                           std::chrono::steady_clock::time_point end)
+{
+  return static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) / 1000.0f;
+}
+
+} // namespace
+
+LevelLoadingScreen::LevelLoadingScreen(const std::string& levelfile, Savegame& savegame,
+                                       Statistics* statistics) :
+  m_levelfile(levelfile),
+  m_savegame(savegame),
+  m_statistics(statistics),
+  m_state(PARSING),
+  m_document_future(),
+  m_document(),
+  m_images_ready(0),
+  m_images_total(0),
+  m_start_time(std::chrono::steady_clock::now()),
+  m_parsed_time()
+{
+  // reading and parsing only touches the document, the rest of the
+  // level gets built on the main thread
+  const std::string filename = m_levelfile;
+  m_document_future = TextureManager::current()->get_thread_pool().schedule([filename]{
+      return std::make_unique<ReaderDocument>(LevelParser::load_document(filename));
+    });
+}
+
+LevelLoadingScreen::~LevelLoadingScreen()
+{
+}
+
+void
+LevelLoadingScreen::setup()
+{
+}
+
+void
+LevelLoadingScreen::update(float )
+{
+  switch (m_state)
+  {
+    case PARSING:
+      if (m_document_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+      {
+        try
+        {
+          m_document = m_document_future.get();
+        }
+        catch(const std::exception& err)
+        {
+          log_fatal << "Couldn't load level '" << m_levelfile << "': " << err.what() << std::endl;
+          m_state = DONE;
+          ScreenManager::current()->pop_screen();
+          return;
+        }
+
+        m_parsed_time = std::chrono::steady_clock::now();
+        LevelParser::preload(*m_document, g_config->lazy_sectors);
+        m_state = DECODING;
+      }
+      break;
+
+    case DECODING:
+    {
+      // sprites that finish parsing add their images to the preloads
+      const bool parsing_sprites = SpriteManager::current()->update_preloads();
+      TextureManager::current()->keep_preloaded_images();
+      TextureManager::current()->get_preload_progress(m_images_ready, m_images_total);
+      if (!parsing_sprites && m_images_ready == m_images_total)
+      {
+        start_session();
+      }
+      break;
+    }
+
+    case DONE:
+      break;
+  }
+}
+
+void
+LevelLoadingScreen::start_session()
+{
+  m_state = DONE;
+
+  const auto now = std::chrono::steady_clock::now();
+  log_info << "loaded " << m_levelfile << " in " << milliseconds_between(m_start_time, now) << " ms: "
+           << milliseconds_between(m_start_time, m_parsed_time) << " ms reading on a worker, "
+           << milliseconds_between(m_parsed_time, now) << " ms parsing sprites and decoding "
+           << m_images_total << " images" << std::endl;
+
+  try
+  {
+    auto session = std::make_unique<GameSession>(m_levelfile, m_savegame, m_statistics,
+                                                 std::move(m_document));
+    ScreenManager::current()->pop_screen();
+    ScreenManager::current()->push_screen(std::move(session));
+  }
+  catch(const std::exception& err)
+  {
+    // GameSession already popped this screen when the level failed
+    log_fatal << "Couldn't start level: " << err.what() << std::endl;
+  }
+}
+
+float
+LevelLoadingScreen::get_progress() const
+{
+  switch (m_state)
+  {
+    case PARSING:
+      return 0.0f;
+
+    case DECODING:
+      if (m_images_total == 0)
+        return PARSE_PROGRESS;
+      return PARSE_PROGRESS + (1.0f - PARSE_PROGRESS) * static_cast<float>(m_images_ready) / static_cast<float>(m_images_total);
+
+    default:
+      return 1.0f;
+  }
+}
+
+void
+LevelLoadingScreen::draw(Compositor& compositor)
+{
+  auto& context = compositor.make_context();
+
+  const float width = static_cast<float>(context.get_width());
+  const float height = static_cast<float>(context.get_height());
+
+  context.set_ambient_color(Color(1.0f, 1.0f, 1.0f, 1.0f));
+  context.color().draw_filled_rect(Vector(0, 0), Vector(width, height),
+                                   Color(0.0f, 0.0f, 0.0f, 1.0f), 0);
+
+  const float py = height / 2.0f - Resources::normal_font->get_height();
+  context.color().draw_center_text(Resources::normal_font, _("Loading..."),
+                                   Vector(0, py), LAYER_FOREGROUND1);
+
+  const Rectf bar(Vector(width / 4.0f, py + Resources::normal_font->get_height() * 1.5f),
+                  Sizef(width / 2.0f, 8.0f));
+  context.color().draw_filled_rect(bar, Color(0.3f, 0.3f, 0.3f, 1.0f), LAYER_FOREGROUND1);
+  context.color().draw_filled_rect(Rectf(bar.p1, Sizef(bar.get_width() * get_progress(), bar.get_height())),
+                                   Color(1.0f, 1.0f, 1.0f, 1.0f), LAYER_FOREGROUND1 + 1);
+}
+
+/* EOF */
@@ -0,0 +1,77 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADING_SCREEN_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADING_SCREEN_HPP
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+
+#include "supertux/screen.hpp"
+
+class ReaderDocument;
+class Savegame;
+class Statistics;
+
+/** Screen that gets a level ready before its GameSession starts.
+    The level file is read and parsed on one of the TextureManager's
+    threads, then the images of its sectors are decoded on them
+    while a progress bar is shown. Object construction, texture
+    uploads and scripting stay on the main thread in GameSession. */
+class LevelLoadingScreen final : public Screen
+{
+public:
+  LevelLoadingScreen(const std::string& levelfile, Savegame& savegame,
+                     Statistics* statistics = nullptr);
+  virtual ~LevelLoadingScreen();
+
+  virtual void setup() override;
+  virtual void draw(Compositor& compositor) override;
+  virtual void update(float elapsed_time) override;
+
+private:
+  enum State { PARSING, DECODING, DONE };
+
+  void start_session();
+
+  /** fraction of the loading that is done, for the progress bar */
+  float get_progress() const;
+
+private:
+  std::string m_levelfile;
+  Savegame& m_savegame;
+  Statistics* m_statistics;
+
+  State m_state;
+  std::future<std::unique_ptr<ReaderDocument> > m_document_future;
+  std::unique_ptr<ReaderDocument> m_document;
+
+  int m_images_ready;
+  int m_images_total;
+
+  std::chrono::steady_clock::time_point m_start_time;
+  std::chrono::steady_clock::time_point m_parsed_time;
+
+private:
+  LevelLoadingScreen(const LevelLoadingScreen&) = delete;
+  LevelLoadingScreen& operator=(const LevelLoadingScreen&) = delete;
+};
+
+#endif
+
+/* EOF */
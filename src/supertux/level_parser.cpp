@@ -27,12 +27,70 @@
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 
+ReaderDocument
+LevelParser::load_document(const std::string& filepath)
+{
+  const std::string compiled = ReaderDocument::get_compiled_filename(filepath);
+
+  // the compiled file remembers the modification time and size of
+  // the text file, it is refused when the text file changed since
+  if (PHYSFS_exists(compiled.c_str()) && PHYSFS_exists(filepath.c_str()))
+  {
+    try
+    {
+      return ReaderDocument::from_compiled_file(compiled, filepath);
+    }
+    catch(const std::exception& err)
+    {
+      log_warning << "[" << compiled << "] couldn't load compiled level, using the text file: "
+                  << err.what() << std::endl;
+    }
+  }
+
+  return ReaderDocument::from_file(filepath);
+}
+
+void
+LevelParser::preload(const ReaderDocument& doc, bool main_only)
+{
+  auto root = doc.get_root();
+  if (root.get_name() != "supertux-level")
+    return;
+
+  auto level = root.get_mapping();
+  int version = 1;
+  level.get("version", version);
+  if (version != 2)
+    return;
+
+  auto iter = level.get_iter();
+  while(iter.next()) {
+    if (iter.get_key() == "sector") {
+      auto sector = iter.as_mapping();
+      std::string name;
+      if (!main_only || (sector.get("name", name) && name == "main")) {
+        SectorParser::preload(sector);
+      }
+    }
+  }
+}
+
 std::unique_ptr<Level>
 LevelParser::from_file(const std::string& filename)
 {
   auto level = std::make_unique<Level>();
   LevelParser parser(*level);
-  parser.load(filename);
+  parser.load(filename, nullptr, false);
+  return level;
+}
+
+std::unique_ptr<Level>
+LevelParser::from_document(const ReaderDocument& doc, const std::string& filename,
+                           bool defer_sectors)
+{
+  auto level = std::make_unique<Level>();
+  LevelParser parser(*level);
+  parser.load(filename, &doc, defer_sectors);
   return level;
 }
 
@@ -85,13 +143,18 @@ LevelParser::LevelParser(Level& level) :
 }
 
 void
-LevelParser::load(const std::string& filepath)
+LevelParser::load(const std::string& filepath, const ReaderDocument* doc, bool defer_sectors)
 {
   try {
     m_level.m_filename = filepath;
     register_translation_directory(filepath);
-    auto doc = ReaderDocument::from_file(filepath);
-    auto root = doc.get_root();
+
+    std::unique_ptr<ReaderDocument> loaded_doc;
+    if (!doc) {
+      loaded_doc = std::make_unique<ReaderDocument>(load_document(filepath));
+      doc = loaded_doc.get();
+    }
+    auto root = doc->get_root();
 
     if(root.get_name() != "supertux-level")
       throw std::runtime_error("file is not a supertux-level file.");
@@ -112,11 +175,28 @@ LevelParser::load(const std::string& filepath)
       level.get("license", m_level.m_license);
       level.get("target-time", m_level.m_target_time);
 
-      auto iter = level.get_iter();
-      while(iter.next()) {
-        if (iter.get_key() == "sector") {
-          auto sector = SectorParser::from_reader(m_level, iter.as_mapping());
-          m_level.add_sector(std::move(sector));
+      if (defer_sectors) {
+        // Level::get_sector() constructs them when they are entered
+        auto iter = level.get_iter();
+        while(iter.next()) {
+          if (iter.get_key() == "sector") {
+            auto sector = iter.as_mapping();
+            std::string name;
+            sector.get("name", name);
+            m_level.add_deferred_sector(name, sector);
+          }
+        }
+      } else {
+        // queue the images of all sectors first, so that they get
+        // decoded while the objects are constructed
+        preload(*doc, false);
+
+        auto iter = level.get_iter();
+        while(iter.next()) {
+          if (iter.get_key() == "sector") {
+            auto sector = SectorParser::from_reader(m_level, iter.as_mapping());
+            m_level.add_sector(std::move(sector));
+          }
         }
       }
 
@@ -21,19 +21,37 @@
 #include <string>
 
 class Level;
+class ReaderDocument;
 class ReaderMapping;
 
 class LevelParser final
 {
 public:
   static std::unique_ptr<Level> from_file(const std::string& filename);
+
+  /** Builds the level from an already loaded document, so that it can
+      be restarted without reading and parsing the file again. With
+      \a defer_sectors the sectors are only constructed when they are
+      first requested, the document has to outlive the level then. */
+  static std::unique_ptr<Level> from_document(const ReaderDocument& doc, const std::string& filename,
+                                              bool defer_sectors = false);
+
+  /** Loads the compiled version of the level when there is one that
+      is at least as new as the text file, the text file otherwise */
+  static ReaderDocument load_document(const std::string& filename);
+
+  /** Queues the images of the level's sectors for decoding, with
+      \a main_only just those of the "main" sector */
+  static void preload(const ReaderDocument& doc, bool main_only);
+
   static std::unique_ptr<Level> from_nothing(const std::string& basedir);
   static std::unique_ptr<Level> from_nothing_worldmap(const std::string& basedir, const std::string& name);
 
 private:
   LevelParser(Level& level);
 
-  void load(const std::string& filepath);
+  /** \a doc may be nullptr, the file is loaded then */
+  void load(const std::string& filepath, const ReaderDocument* doc, bool defer_sectors);
   void load_old_format(const ReaderMapping& reader);
   void create(const std::string& filepath, const std::string& levelname, bool worldmap);
 
@@ -106,6 +106,14 @@ LevelIntro::update(float elapsed_time)
 
 }
 
+bool
+LevelIntro::needs_redraw() const
+{
+  // the walk cycle is slow enough for the idle redraw rate, only the
+  // jump needs the full framerate
+  return m_player_sprite_vy != 0.0f;
+}
+
 void LevelIntro::draw_stats_line(DrawingContext& context, int& py, const std::string& name, const std::string& stat)
 {
   std::stringstream ss;
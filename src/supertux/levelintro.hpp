@@ -43,6 +43,7 @@ public:
   virtual void setup() override;
   virtual void draw(Compositor& compositor) override;
   virtual void update(float elapsed_time) override;
+  virtual bool needs_redraw() const override;
 
 private:
   void draw_stats_line(DrawingContext& context, int& py, const std::string& name, const std::string& stat);
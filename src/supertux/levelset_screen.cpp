@@ -17,13 +17,14 @@
 #include "supertux/levelset_screen.hpp"
 
 #include "editor/editor.hpp"
-#include "supertux/game_session.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_loading_screen.hpp"
 #include "supertux/levelset.hpp"
 #include "supertux/savegame.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/screen_manager.hpp"
 #include "util/file_system.hpp"
+#include "util/log.hpp"
 
 LevelsetScreen::LevelsetScreen(const std::string& basedir, const std::string& level_filename,
                                Savegame& savegame) :
@@ -80,8 +81,8 @@ LevelsetScreen::setup()
       log_warning << "Editor is still active, quiting Levelset screen" << std::endl;
       ScreenManager::current()->pop_screen();
     } else {
-      auto screen = std::make_unique<GameSession>(FileSystem::join(m_basedir, m_level_filename),
-                                                  m_savegame);
+      auto screen = std::make_unique<LevelLoadingScreen>(FileSystem::join(m_basedir, m_level_filename),
+                                                         m_savegame);
       ScreenManager::current()->push_screen(std::move(screen));
     }
   }
@@ -547,6 +547,10 @@ Main::run(int argc, char** argv)
         args.print_datadir();
         return 0;
 
+      case CommandLineArguments::COMPILE_LEVEL:
+        args.compile_level_file();
+        return 0;
+
       default:
         launch_game(args);
         break;
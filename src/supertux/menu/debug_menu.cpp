@@ -20,8 +20,11 @@
 #include <sstream>
 
 #include "gui/item_stringselect.hpp"
+#include "gui/item_toggle.hpp"
 #include "supertux/debug.hpp"
+#include "supertux/sector.hpp"
 #include "util/gettext.hpp"
+#include "util/log.hpp"
 
 DebugMenu::DebugMenu() :
   next_game_speed(0)
@@ -62,6 +65,9 @@ DebugMenu::DebugMenu() :
   add_toggle(-1, _("Use Bitmap Fonts"),
              []{ return g_debug.get_use_bitmap_fonts(); },
              [](bool value){ g_debug.set_use_bitmap_fonts(value); });
+  add_toggle(-1, _("Record Snapshots"), &g_debug.record_snapshots)
+    .set_help(_("Keep the last seconds of the sector to allow rewinding"));
+  add_entry(MNID_REWIND, _("Rewind 2 Seconds"));
 
   add_hl();
   add_back(_("Back"));
@@ -70,6 +76,18 @@ DebugMenu::DebugMenu() :
 void
 DebugMenu::menu_action(MenuItem& item)
 {
+  switch (item.id)
+  {
+    case MNID_REWIND:
+      if (auto sector = Sector::current())
+      {
+        if (!sector->rewind(2.0f))
+        {
+          log_info << "nothing to rewind, enable \"Record Snapshots\" first" << std::endl;
+        }
+      }
+      break;
+  }
 }
 
 /* EOF */
@@ -23,7 +23,8 @@ class DebugMenu final : public Menu
 {
 private:
   enum {
-    MNID_GAME_SPEED
+    MNID_GAME_SPEED,
+    MNID_REWIND
   };
 
   int next_game_speed;
@@ -17,9 +17,11 @@
 #include "supertux/menu/editor_menu.hpp"
 
 #include "gui/dialog.hpp"
+#include "gui/item_toggle.hpp"
 #include "gui/menu_item.hpp"
 #include "gui/menu_manager.hpp"
 #include "editor/editor.hpp"
+#include "object/tilemap.hpp"
 #include "supertux/menu/menu_storage.hpp"
 #include "util/gettext.hpp"
 #include "video/compositor.hpp"
@@ -60,6 +62,8 @@ EditorMenu::EditorMenu()
   add_toggle(-1, _("Show grid (F8)"), &EditorInputCenter::render_grid);
   add_toggle(-1, _("Render background"), &EditorInputCenter::render_background);
   add_toggle(-1, _("Show scroller (F9)"), &EditorScroller::rendered);
+  add_toggle(-1, _("Save compact tilemaps"), &TileMap::s_compact_tiles)
+    .set_help(_("Run-length encode the tiles when saving, levels saved this way can't be opened by older versions"));
 
   add_submenu(worldmap ? _("Worldmap properties") : _("Level properties"),
               MenuStorage::EDITOR_LEVEL_MENU);
@@ -55,6 +55,10 @@ enum OptionsMenuIDs {
   MNID_ASPECTRATIO,
   MNID_VSYNC,
   MNID_FRAMERATE,
+  MNID_FRAME_INTERPOLATION,
+  MNID_LIGHTMAP_DOWNSCALE,
+  MNID_DYNAMIC_RESOLUTION,
+  MNID_TEXTURE_CACHE,
   MNID_SOUND,
   MNID_MUSIC,
   MNID_SOUND_VOLUME,
@@ -63,7 +67,8 @@ enum OptionsMenuIDs {
   MNID_CHRISTMAS_MODE,
   MNID_TRANSITIONS,
   MNID_CONFIRMATION_DIALOG,
-  MNID_PAUSE_ON_FOCUSLOSS
+  MNID_PAUSE_ON_FOCUSLOSS,
+  MNID_LAZY_SECTORS
 };
 
 OptionsMenu::OptionsMenu(bool complete) :
@@ -72,6 +77,7 @@ OptionsMenu::OptionsMenu(bool complete) :
   next_resolution(0),
   next_vsync(0),
   next_framerate(0),
+  next_lightmap_downscale(0),
   next_sound_volume(0),
   next_music_volume(0),
   magnifications(),
@@ -79,6 +85,7 @@ OptionsMenu::OptionsMenu(bool complete) :
   resolutions(),
   vsyncs(),
   framerates(),
+  lightmap_downscales(),
   sound_volumes(),
   music_volumes()
 {
@@ -229,6 +236,34 @@ OptionsMenu::OptionsMenu(bool complete) :
     }
   }
 
+  lightmap_downscales.push_back(_("auto"));
+  lightmap_downscales.push_back("1/5");
+  lightmap_downscales.push_back("1/8");
+  lightmap_downscales.push_back("1/10");
+  switch (g_config->lightmap_downscale)
+  {
+    case 0:
+      next_lightmap_downscale = 0;
+      break;
+
+    case 5:
+      next_lightmap_downscale = 1;
+      break;
+
+    case 8:
+      next_lightmap_downscale = 2;
+      break;
+
+    case 10:
+      next_lightmap_downscale = 3;
+      break;
+
+    default: // downscale not in our list but accept anyway
+      next_lightmap_downscale = static_cast<int>(lightmap_downscales.size());
+      lightmap_downscales.push_back("1/" + std::to_string(g_config->lightmap_downscale));
+      break;
+  }
+
   { // vsync
     vsyncs.push_back("on");
     vsyncs.push_back("off");
@@ -351,6 +386,18 @@ OptionsMenu::OptionsMenu(bool complete) :
   MenuItem& framerate = add_string_select(MNID_FRAMERATE, _("Framerate"), &next_framerate, framerates);
   framerate.set_help(_("Change the maximum framerate of the game"));
 
+  add_toggle(MNID_FRAME_INTERPOLATION, _("Frame Interpolation"), &g_config->frame_interpolation)
+    .set_help(_("Run the game at a fixed speed and smooth out the movement in between, for high refresh rate screens"));
+
+  MenuItem& lightmap_downscale = add_string_select(MNID_LIGHTMAP_DOWNSCALE, _("Lighting Resolution"), &next_lightmap_downscale, lightmap_downscales);
+  lightmap_downscale.set_help(_("Lower the resolution of the lighting in dark levels to improve performance"));
+
+  add_toggle(MNID_DYNAMIC_RESOLUTION, _("Dynamic Resolution"), &g_config->dynamic_resolution)
+    .set_help(_("Render the game at a lower resolution when the computer can't keep up, menus stay sharp"));
+
+  add_toggle(MNID_TEXTURE_CACHE, _("Texture Cache"), &g_config->texture_cache)
+    .set_help(_("Store decoded images on disk to speed up loading, takes effect after a restart"));
+
   MenuItem& aspect = add_string_select(MNID_ASPECTRATIO, _("Aspect Ratio"), &next_aspect_ratio, aspect_ratios);
   aspect.set_help(_("Adjust the aspect ratio"));
 
@@ -395,6 +442,8 @@ OptionsMenu::OptionsMenu(bool complete) :
   add_toggle(MNID_CONFIRMATION_DIALOG, _("Confirmation Dialog"), &g_config->confirmation_dialog).set_help("Confirm aborting level");
   add_toggle(MNID_CONFIRMATION_DIALOG, _("Pause on focus loss"), &g_config->pause_on_focusloss)
     .set_help("Automatically pause the game when the window loses focus");
+  add_toggle(MNID_LAZY_SECTORS, _("Load Sectors on Demand"), &g_config->lazy_sectors)
+    .set_help(_("Build bonus areas only when they are entered, level totals are complete at the end of the level"));
   add_hl();
   add_back(_("Back"));
 }
@@ -475,6 +524,32 @@ OptionsMenu::menu_action(MenuItem& item)
       ScreenManager::current()->set_target_framerate(std::stof(framerates[next_framerate]));
       break;
 
+    case MNID_LIGHTMAP_DOWNSCALE:
+      switch (next_lightmap_downscale)
+      {
+        case 0:
+          g_config->lightmap_downscale = 0; // Magic value
+          break;
+
+        case 1:
+          g_config->lightmap_downscale = 5;
+          break;
+
+        case 2:
+          g_config->lightmap_downscale = 8;
+          break;
+
+        case 3:
+          g_config->lightmap_downscale = 10;
+          break;
+
+        default:
+          // value from the config file that isn't in our list, keep it
+          break;
+      }
+      VideoSystem::current()->apply_config();
+      break;
+
     case MNID_VSYNC:
       switch (next_vsync)
       {
@@ -34,6 +34,7 @@ class OptionsMenu final : public Menu
     int next_resolution;
     int next_vsync;
     int next_framerate;
+    int next_lightmap_downscale;
     int next_sound_volume;
     int next_music_volume;
 
@@ -42,6 +43,7 @@ class OptionsMenu final : public Menu
     std::vector<std::string> resolutions;
     std::vector<std::string> vsyncs;
     std::vector<std::string> framerates;
+    std::vector<std::string> lightmap_downscales;
     std::vector<std::string> sound_volumes;
     std::vector<std::string> music_volumes;
 };
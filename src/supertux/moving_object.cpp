@@ -16,14 +16,18 @@
 
 #include "supertux/moving_object.hpp"
 
+#include <math.h>
+
 #include "editor/resizer.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/snapshot.hpp"
 #include "util/writer.hpp"
 
 MovingObject::MovingObject() :
   bbox(),
   movement(),
   group(COLGROUP_MOVING),
+  previous_pos(),
   dest()
 {
 }
@@ -33,6 +37,7 @@ MovingObject::MovingObject(const ReaderMapping& reader) :
   bbox(),
   movement(),
   group(COLGROUP_MOVING),
+  previous_pos(),
   dest()
 {
 }
@@ -48,6 +53,47 @@ MovingObject::save(Writer& writer) {
   writer.write("y", bbox.p1.y);
 }
 
+void
+MovingObject::backup(SnapshotWriter& writer) const
+{
+  writer.write(bbox.p1.x);
+  writer.write(bbox.p1.y);
+  writer.write(bbox.p2.x);
+  writer.write(bbox.p2.y);
+  writer.write(movement.x);
+  writer.write(movement.y);
+}
+
+void
+MovingObject::restore(SnapshotReader& reader)
+{
+  reader.read(bbox.p1.x);
+  reader.read(bbox.p1.y);
+  reader.read(bbox.p2.x);
+  reader.read(bbox.p2.y);
+  reader.read(movement.x);
+  reader.read(movement.y);
+  dest = bbox;
+  previous_pos = bbox.p1;
+}
+
+Vector
+MovingObject::get_interpolated_pos(float alpha) const
+{
+  // anything faster than this has been teleported or respawned
+  static const float max_distance = 64.0f;
+
+  const Vector delta = bbox.p1 - previous_pos;
+  if (fabsf(delta.x) > max_distance || fabsf(delta.y) > max_distance)
+  {
+    return bbox.p1;
+  }
+  else
+  {
+    return previous_pos + delta * alpha;
+  }
+}
+
 void
 MovingObject::edit_bbox() {
   if (!is_valid()) {
@@ -109,6 +109,9 @@ public:
     return "moving-object";
   }
 
+  virtual void backup(SnapshotWriter& writer) const override;
+  virtual void restore(SnapshotReader& reader) override;
+
   const Vector& get_pos() const
   {
     return bbox.p1;
@@ -168,6 +171,18 @@ public:
     return group;
   }
 
+  /** Remember the current position as the start of the
+      interpolation, called by the Sector before each update */
+  void store_previous_pos()
+  {
+    previous_pos = bbox.p1;
+  }
+
+  /** Returns the position at \a alpha of the way from the position
+      before the last update to the current one. Objects that jumped
+      further than a regular movement are not interpolated. */
+  Vector get_interpolated_pos(float alpha) const;
+
 protected:
   void set_group(CollisionGroup group_)
   {
@@ -184,6 +199,10 @@ protected:
   /** The collision group */
   CollisionGroup group;
 
+private:
+  /** Position before the last update, used for interpolation */
+  Vector previous_pos;
+
 private:
   /** this is only here for internal collision detection use (don't touch this
       from outside collision detection code)
@@ -52,6 +52,14 @@ public:
    * updates and logic here
    */
   virtual void update(float elapsed_time) = 0;
+
+  /**
+   * returns true when the screen has changed since the last draw call.
+   * Screens that are static most of the time can return false to let
+   * the ScreenManager skip drawing frames while nothing happens.
+   */
+  virtual bool needs_redraw() const
+  { return true; }
 };
 
 #endif
@@ -18,6 +18,8 @@
 #include "supertux/screen_manager.hpp"
 
 #include "audio/sound_manager.hpp"
+#include "control/controller.hpp"
+#include "control/input_manager.hpp"
 #include "editor/editor.hpp"
 #include "gui/menu_manager.hpp"
 #include "scripting/scripting.hpp"
@@ -34,12 +36,42 @@
 #include "supertux/sector.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
+#include "video/texture_manager.hpp"
+#include "video/video_system.hpp"
 
+#include <algorithm>
 #include <stdio.h>
 
 /** don't skip more than every 2nd frame */
 static const int MAX_FRAME_SKIP = 2;
 
+/** static screens are still redrawn at this rate, so that slow
+    animations like the blinking menu selection keep running */
+static const Uint64 IDLE_FRAMERATE = 20;
+
+/** the last milliseconds of a wait are spent spinning, as SDL_Delay()
+    often oversleeps */
+static const Uint64 SPIN_MILLISECONDS = 2;
+
+/** Wait until the performance counter reaches \a deadline */
+static void wait_until(Uint64 deadline)
+{
+  const Uint64 ticks_per_millisecond = SDL_GetPerformanceFrequency() / 1000;
+
+  while (true)
+  {
+    const Uint64 ticks = SDL_GetPerformanceCounter();
+    if (ticks >= deadline)
+      return;
+
+    const Uint64 remaining = (deadline - ticks) / ticks_per_millisecond;
+    if (remaining > SPIN_MILLISECONDS)
+    {
+      SDL_Delay(static_cast<Uint32>(remaining - SPIN_MILLISECONDS));
+    }
+  }
+}
+
 ScreenManager::ScreenManager(VideoSystem& video_system) :
   m_waiting_threads(),
   m_video_system(video_system),
@@ -47,6 +79,9 @@ ScreenManager::ScreenManager(VideoSystem& video_system) :
   m_menu_manager(new MenuManager),
   m_speed(1.0),
   m_target_framerate(60.0f),
+  m_dynamic_resolution(),
+  m_redraw(true),
+  m_last_draw_ticks(0),
   m_actions(),
   m_fps(0),
   m_screen_fade(),
@@ -165,6 +200,8 @@ ScreenManager::draw(Compositor& compositor)
 
   static Uint32 fps_ticks = SDL_GetTicks();
 
+  const Uint64 draw_start = SDL_GetPerformanceCounter();
+
   // draw the actual screen
   m_screen_stack.back()->draw(compositor);
 
@@ -192,6 +229,21 @@ ScreenManager::draw(Compositor& compositor)
   // render everything
   compositor.render();
 
+  // GL drivers defer most of the work until the swap, so wait for
+  // it to be done to time the whole frame; the wait for vsync in
+  // flip() isn't counted against the frame budget
+  if (g_config->dynamic_resolution)
+  {
+    m_video_system.finish();
+  }
+  const Uint64 draw_ticks = SDL_GetPerformanceCounter() - draw_start;
+  m_video_system.flip();
+
+  TextureManager::current()->update();
+
+  update_scene_scale(static_cast<float>(draw_ticks) /
+                     static_cast<float>(SDL_GetPerformanceFrequency()));
+
   /* Calculate frames per second */
   if (g_config->show_fps)
   {
@@ -207,6 +259,37 @@ ScreenManager::draw(Compositor& compositor)
   }
 }
 
+bool
+ScreenManager::needs_redraw() const
+{
+  if (m_screen_fade ||
+      m_menu_manager->needs_redraw() ||
+      Console::current()->is_visible() ||
+      m_screen_stack.back()->needs_redraw())
+  {
+    return true;
+  }
+
+  // held controls can change menus without generating new events
+  return InputManager::current()->get_controller()->any_hold();
+}
+
+void
+ScreenManager::update_scene_scale(float draw_time)
+{
+  if (g_config->dynamic_resolution)
+  {
+    m_dynamic_resolution.set_budget(1.0f / m_target_framerate);
+    m_dynamic_resolution.update(draw_time);
+  }
+  else
+  {
+    m_dynamic_resolution.reset();
+  }
+
+  m_video_system.set_scene_scale(m_dynamic_resolution.get_scale());
+}
+
 void
 ScreenManager::update_gamelogic(float elapsed_time)
 {
@@ -236,6 +319,8 @@ ScreenManager::process_events()
   auto session = GameSession::current();
   while (SDL_PollEvent(&event))
   {
+    m_redraw = true;
+
     InputManager::current()->process_event(event);
 
     m_menu_manager->event(event);
@@ -371,6 +456,7 @@ ScreenManager::handle_screen_switch()
 
           if (!m_screen_stack.empty())
           {
+            m_redraw = true;
             m_screen_stack.back()->setup();
             m_speed = 1.0;
             m_waiting_threads.wakeup();
@@ -384,21 +470,31 @@ ScreenManager::handle_screen_switch()
 void
 ScreenManager::run()
 {
-  Uint32 last_ticks = 0;
-  Uint32 elapsed_ticks = 0;
+  const double ticks_per_second = static_cast<double>(SDL_GetPerformanceFrequency());
+
+  Uint64 last_ticks = SDL_GetPerformanceCounter();
+  Uint64 elapsed_ticks = 0;
 
   handle_screen_switch();
 
   while (!m_screen_stack.empty())
   {
-    Uint32 ticks = SDL_GetTicks();
+    // with interpolation the logic runs at a fixed rate and the
+    // target framerate only limits how often the screen is drawn
+    const bool interpolate = g_config->frame_interpolation;
+    const float logic_rate = interpolate ? LOGICAL_FPS : m_target_framerate;
+
+    /** ticks (as returned from SDL_GetPerformanceCounter) per logic step */
+    const Uint64 ticks_per_step = static_cast<Uint64>(ticks_per_second / logic_rate * g_debug.get_game_speed_multiplier());
+
+    /** ticks per drawn frame */
+    const Uint64 ticks_per_frame = static_cast<Uint64>(ticks_per_second / m_target_framerate);
+
+    const Uint64 ticks = SDL_GetPerformanceCounter();
     elapsed_ticks += ticks - last_ticks;
     last_ticks = ticks;
 
-    /** ticks (as returned from SDL_GetTicks) per frame */
-    const Uint32 ticks_per_frame = static_cast<Uint32>(1000.0 / m_target_framerate * g_debug.get_game_speed_multiplier());
-
-    if (elapsed_ticks > ticks_per_frame*4)
+    if (elapsed_ticks > ticks_per_step*4)
     {
       // when the game loads up or levels are switched the
       // elapsed_ticks grows extremely large, so we just ignore those
@@ -406,20 +502,21 @@ ScreenManager::run()
       elapsed_ticks = 0;
     }
 
-    if (elapsed_ticks < ticks_per_frame)
+    if (!interpolate && elapsed_ticks < ticks_per_step)
     {
-      Uint32 delay_ticks = ticks_per_frame - elapsed_ticks;
-      SDL_Delay(delay_ticks);
-      last_ticks += delay_ticks;
-      elapsed_ticks += delay_ticks;
+      wait_until(ticks + ticks_per_step - elapsed_ticks);
+
+      const Uint64 now = SDL_GetPerformanceCounter();
+      elapsed_ticks += now - last_ticks;
+      last_ticks = now;
     }
 
     int frames = 0;
 
-    while (elapsed_ticks >= ticks_per_frame && frames < MAX_FRAME_SKIP)
+    while (elapsed_ticks >= ticks_per_step && frames < MAX_FRAME_SKIP)
     {
-      elapsed_ticks -= ticks_per_frame;
-      float timestep = 1.0f / m_target_framerate;
+      elapsed_ticks -= ticks_per_step;
+      float timestep = 1.0f / logic_rate;
       g_real_time += timestep;
       timestep *= m_speed;
       g_game_time += timestep;
@@ -429,15 +526,36 @@ ScreenManager::run()
       frames += 1;
     }
 
+    g_frame_alpha = interpolate ?
+      std::min(1.0f, static_cast<float>(elapsed_ticks) / static_cast<float>(ticks_per_step)) :
+      1.0f;
+
     if (!m_screen_stack.empty())
     {
-      Compositor compositor(m_video_system);
-      draw(compositor);
+      // when nothing changed the previous frame stays on screen and
+      // composition is skipped, apart from the occasional idle redraw
+      const bool dirty = needs_redraw();
+      const Uint64 idle_ticks = static_cast<Uint64>(ticks_per_second) / IDLE_FRAMERATE;
+      if (dirty || m_redraw || ticks - m_last_draw_ticks >= idle_ticks)
+      {
+        Compositor compositor(m_video_system);
+        draw(compositor);
+        m_last_draw_ticks = ticks;
+      }
+
+      // draw one more frame after things settle down, so the final
+      // state of an animation makes it to the screen
+      m_redraw = dirty;
     }
 
     SoundManager::current()->update();
 
     handle_screen_switch();
+
+    if (interpolate)
+    {
+      wait_until(ticks + ticks_per_frame);
+    }
   }
 }
 
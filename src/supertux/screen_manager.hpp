@@ -18,11 +18,13 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_SCREEN_MANAGER_HPP
 #define HEADER_SUPERTUX_SUPERTUX_SCREEN_MANAGER_HPP
 
+#include <SDL.h>
 #include <memory>
 
 #include "scripting/thread_queue.hpp"
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
+#include "video/dynamic_resolution.hpp"
 
 class Compositor;
 class DrawingContext;
@@ -60,6 +62,8 @@ private:
   void draw_fps(DrawingContext& context, float fps);
   void draw_player_pos(DrawingContext& context);
   void draw(Compositor& compositor);
+  bool needs_redraw() const;
+  void update_scene_scale(float draw_time);
   void update_gamelogic(float elapsed_time);
   void process_events();
   void handle_screen_switch();
@@ -72,6 +76,15 @@ private:
   float m_speed;
   float m_target_framerate;
 
+  /** Picks the resolution the scene is rendered at */
+  DynamicResolution m_dynamic_resolution;
+
+  /** Set by input and screen switches, forces the next frame to be drawn */
+  bool m_redraw;
+
+  /** Performance counter value of the last drawn frame */
+  Uint64 m_last_draw_ticks;
+
   struct Action
   {
     enum Type { PUSH_ACTION, POP_ACTION, QUIT_ACTION };
@@ -29,10 +29,12 @@
 #include "object/camera.hpp"
 #include "object/display_effect.hpp"
 #include "object/gradient.hpp"
+#include "object/moving_sprite.hpp"
 #include "object/player.hpp"
 #include "object/portable.hpp"
 #include "object/pulsing_light.hpp"
 #include "object/smoke_cloud.hpp"
+#include "object/static_light_source.hpp"
 #include "object/text_array_object.hpp"
 #include "object/text_object.hpp"
 #include "object/tilemap.hpp"
@@ -43,16 +45,30 @@
 #include "supertux/constants.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/game_session.hpp"
+#include "supertux/globals.hpp"
 #include "supertux/level.hpp"
 #include "supertux/game_object_factory.hpp"
 #include "supertux/savegame.hpp"
+#include "supertux/snapshot.hpp"
+#include "supertux/snapshot_buffer.hpp"
 #include "supertux/spawn_point.hpp"
+#include "supertux/static_lightmap.hpp"
 #include "supertux/tile.hpp"
 #include "util/file_system.hpp"
 #include "util/writer.hpp"
+#include "video/texture_manager.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
+namespace {
+
+/** rewind history: 16 states per second for the last 10 seconds */
+const float SNAPSHOT_INTERVAL = 1.0f / 16.0f;
+const size_t SNAPSHOT_CAPACITY = 160;
+const size_t SNAPSHOT_KEYFRAME_INTERVAL = 32;
+
+} // namespace
+
 Sector* Sector::s_current = nullptr;
 
 Sector::Sector(Level& parent) :
@@ -68,9 +84,13 @@ Sector::Sector(Level& parent) :
   m_ambient_light_fade_duration(0.0f),
   m_ambient_light_fade_accum(0.0f),
   m_foremost_layer(),
+  m_last_update_time(0.0f),
   m_collision_system(new CollisionSystem(*this)),
+  m_static_lightmap(new StaticLightmap),
   m_gravity(10.0),
   m_music(),
+  m_snapshots(new SnapshotBuffer(SNAPSHOT_CAPACITY, SNAPSHOT_KEYFRAME_INTERVAL)),
+  m_snapshot_time(0.0f),
   m_spawnpoints(),
   m_portables(),
   m_player(nullptr),
@@ -244,6 +264,9 @@ Sector::deactivate()
 
   unexpose("settings");
 
+  // release the baked chunks, they are rebaked on the next activation
+  m_static_lightmap->invalidate();
+
   s_current = nullptr;
 }
 
@@ -321,11 +344,115 @@ Sector::update(float elapsed_time)
     }
   }
 
+  for(auto& moving_object : m_collision_system->get_moving_objects()) {
+    moving_object->store_previous_pos();
+  }
+  m_last_update_time = g_real_time;
+
   GameObjectManager::update(elapsed_time);
 
   /* Handle all possible collisions. */
   m_collision_system->update();
   update_game_objects();
+
+  prefetch_textures();
+
+  if (g_debug.record_snapshots)
+  {
+    m_snapshot_time += elapsed_time;
+    if (m_snapshot_time >= SNAPSHOT_INTERVAL)
+    {
+      m_snapshot_time = 0.0f;
+      m_snapshots->push(backup());
+    }
+  }
+  else if (!m_snapshots->empty())
+  {
+    m_snapshots->clear();
+  }
+}
+
+std::vector<uint8_t>
+Sector::backup() const
+{
+  SnapshotWriter writer;
+  for(const auto& object : get_objects())
+  {
+    if (!object->is_valid())
+      continue;
+
+    SnapshotWriter object_writer;
+    object->backup(object_writer);
+    if (object_writer.size() == 0)
+      continue;
+
+    writer.write(object->get_uid());
+    writer.write(static_cast<uint32_t>(object_writer.size()));
+    writer.write_bytes(object_writer.get_data().data(), object_writer.size());
+  }
+  return writer.release();
+}
+
+void
+Sector::restore(const std::vector<uint8_t>& state)
+{
+  SnapshotReader reader(state.data(), state.size());
+  while (!reader.eof())
+  {
+    UID uid;
+    uint32_t size;
+    reader.read(uid);
+    reader.read(size);
+    const uint8_t* data = reader.read_bytes(size);
+
+    if (auto object = get_object_by_uid<GameObject>(uid))
+    {
+      SnapshotReader object_reader(data, size);
+      object->restore(object_reader);
+    }
+  }
+}
+
+bool
+Sector::rewind(float seconds)
+{
+  if (m_snapshots->empty())
+    return false;
+
+  const size_t age = std::min(static_cast<size_t>(seconds / SNAPSHOT_INTERVAL),
+                              m_snapshots->size() - 1);
+  restore(m_snapshots->get(age));
+  m_snapshots->drop_newest(age);
+  m_snapshot_time = 0.0f;
+
+  log_info << "rewound " << static_cast<float>(age) * SNAPSHOT_INTERVAL << "s, "
+           << m_snapshots->size() << " states left ("
+           << m_snapshots->get_memory_usage() / 1024 << " KiB)" << std::endl;
+  return true;
+}
+
+void
+Sector::prefetch_textures() const
+{
+  if (!TextureManager::current()->has_evicted_textures())
+    return;
+
+  // objects that are in the active region, but not yet on screen
+  const Rectf active_region = get_active_region();
+  const Rectf view(m_camera->get_translation(),
+                   Sizef(static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT)));
+
+  for(const auto& moving_object : m_collision_system->get_moving_objects())
+  {
+    const Rectf& bbox = moving_object->get_bbox();
+    if (active_region.contains(bbox) && !view.contains(bbox))
+    {
+      if (auto moving_sprite = dynamic_cast<MovingSprite*>(moving_object))
+      {
+        moving_sprite->prefetch_textures();
+      }
+    }
+  }
 }
 
 bool
@@ -341,6 +468,7 @@ Sector::before_object_add(const GameObjectPtr& object)
   if (movingobject)
   {
     m_collision_system->add(movingobject);
+    movingobject->store_previous_pos();
   }
 
   auto portable = dynamic_cast<Portable*>(object.get());
@@ -349,6 +477,12 @@ Sector::before_object_add(const GameObjectPtr& object)
     m_portables.push_back(portable);
   }
 
+  auto light_source = dynamic_cast<StaticLightSource*>(object.get());
+  if(light_source)
+  {
+    m_static_lightmap->add(*light_source);
+  }
+
   auto camera_ = dynamic_cast<Camera*>(object.get());
   if(camera_) {
     if(m_camera != nullptr) {
@@ -398,6 +532,10 @@ Sector::before_object_remove(const GameObjectPtr& object)
   if (moving_object) {
     m_collision_system->remove(moving_object);
   }
+  auto light_source = dynamic_cast<StaticLightSource*>(object.get());
+  if (light_source) {
+    m_static_lightmap->remove(*light_source);
+  }
 
   if(s_current == this)
     try_unexpose(object);
@@ -406,11 +544,19 @@ Sector::before_object_remove(const GameObjectPtr& object)
 void
 Sector::draw(DrawingContext& context)
 {
+  // only interpolate when the sector got updated in the last step,
+  // otherwise (e.g. while paused) the previous positions are stale
+  const float alpha = (m_last_update_time == g_real_time) ? g_frame_alpha : 1.0f;
+
   context.set_ambient_color( m_ambient_light );
   context.push_transform();
-  context.set_translation(m_camera->get_translation());
+  context.set_translation(m_camera->get_interpolated_translation(alpha));
+
+  // has to come first, it decides which lights are drawn from the
+  // baked chunks and which draw themselves
+  m_static_lightmap->draw(context);
 
-  GameObjectManager::draw(context);
+  GameObjectManager::draw(context, alpha);
 
   if (g_debug.show_collision_rects) {
     m_collision_system->draw(context);
@@ -572,6 +718,14 @@ Sector::change_solid_tiles(uint32_t old_tile_id, uint32_t new_tile_id)
   }
 }
 
+void
+Sector::change_solid_tiles(const std::vector<std::pair<uint32_t, uint32_t> >& replacements)
+{
+  for(auto& solids: get_solid_tilemaps()) {
+    solids->change_all(replacements);
+  }
+}
+
 void
 Sector::set_ambient_light(const Color& ambient_light)
 {
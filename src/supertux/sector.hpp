@@ -17,6 +17,7 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_SECTOR_HPP
 #define HEADER_SUPERTUX_SUPERTUX_SECTOR_HPP
 
+#include <utility>
 #include <vector>
 #include <stdint.h>
 
@@ -42,7 +43,9 @@ class Portable;
 class ReaderMapping;
 class Rectf;
 class Size;
+class SnapshotBuffer;
 class SpawnPoint;
+class StaticLightmap;
 class TileMap;
 class Vector;
 class Writer;
@@ -153,9 +156,25 @@ public:
   /** resize all tilemaps with given size */
   void resize_sector(const Size& old_size, const Size& new_size, const Size& resize_offset);
 
+  /** Serializes the runtime state of all objects in the sector, see
+      GameObject::backup() */
+  std::vector<uint8_t> backup() const;
+
+  /** Restores a state produced by backup(). Objects that were
+      removed since are skipped, objects added since are kept as they
+      are. */
+  void restore(const std::vector<uint8_t>& state);
+
+  /** Goes back to the recorded state closest to the given number of
+      seconds ago, returns false if nothing was recorded */
+  bool rewind(float seconds);
+
   /** globally changes solid tilemaps' tile ids */
   void change_solid_tiles(uint32_t old_tile_id, uint32_t new_tile_id);
 
+  /** changes several tile ids at once, see TileMap::change_all() */
+  void change_solid_tiles(const std::vector<std::pair<uint32_t, uint32_t> >& replacements);
+
   /** get/set color of ambient light */
   void set_ambient_light(const Color& ambient_light);
   float get_ambient_red() const;
@@ -191,6 +210,10 @@ private:
 
   int calculate_foremost_layer() const;
 
+  /** Pages in evicted textures of objects that are about to scroll
+      into view */
+  void prefetch_textures() const;
+
   /** Convert tiles into their corresponding GameObjects (e.g.
       bonusblocks, add light to lava tiles) */
   void convert_tiles2gameobject();
@@ -226,12 +249,25 @@ private:
 
   int m_foremost_layer;
 
+  /** g_real_time of the last update, used to tell whether positions
+      can be interpolated */
+  float m_last_update_time;
+
 private:
   std::unique_ptr<CollisionSystem> m_collision_system;
 
+  /** Cache for the lights that don't change, see StaticLightmap */
+  std::unique_ptr<StaticLightmap> m_static_lightmap;
+
   float m_gravity;
   std::string m_music;
 
+  /** States recorded for rewind() while g_debug.record_snapshots is set */
+  std::unique_ptr<SnapshotBuffer> m_snapshots;
+
+  /** game time since the last recorded state */
+  float m_snapshot_time;
+
 public:
   // some special objects, where we need direct access
   // (try to avoid accessing them directly)
@@ -18,6 +18,7 @@
 
 #include <iostream>
 #include <physfs.h>
+#include <sexp/value.hpp>
 
 #include "badguy/jumpy.hpp"
 #include "editor/editor.hpp"
@@ -30,6 +31,7 @@
 #include "object/rain_particle_system.hpp"
 #include "object/snow_particle_system.hpp"
 #include "object/tilemap.hpp"
+#include "sprite/sprite_manager.hpp"
 #include "supertux/level.hpp"
 #include "supertux/game_object_factory.hpp"
 #include "supertux/sector.hpp"
@@ -38,11 +40,26 @@
 #include "supertux/tile_manager.hpp"
 #include "util/reader_collection.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+#include "video/texture_manager.hpp"
 
 static const std::string DEFAULT_BG_TOP    = "images/background/BlueRock_Forest/blue-top.jpg";
 static const std::string DEFAULT_BG_MIDDLE = "images/background/BlueRock_Forest/blue-middle.jpg";
 static const std::string DEFAULT_BG_BOTTOM = "images/background/BlueRock_Forest/blue-bottom.jpg";
 
+/** Queues every .sprite file that \a sx mentions, which also catches
+    objects nested in others, like the contents of bonus blocks */
+static void preload_sprites(const sexp::Value& sx)
+{
+  if (sx.is_array()) {
+    for(const auto& item : sx.as_array()) {
+      preload_sprites(item);
+    }
+  } else if (sx.is_string() && StringUtil::has_suffix(sx.as_string(), ".sprite")) {
+    SpriteManager::current()->preload(sx.as_string());
+  }
+}
+
 std::unique_ptr<Sector>
 SectorParser::from_reader(Level& level, const ReaderMapping& reader)
 {
@@ -70,6 +87,39 @@ SectorParser::from_nothing(Level& level)
   return sector;
 }
 
+void
+SectorParser::preload(const ReaderMapping& sector)
+{
+  auto iter = sector.get_iter();
+  while(iter.next()) {
+    if (!iter.is_pair())
+      continue;
+
+    // sector properties like (name "main") aren't objects, errors
+    // are left for parse() to report
+    try {
+      auto object = iter.as_mapping();
+
+      // sprites get parsed on the TextureManager's threads
+      std::string sprite_name;
+      if (object.get("sprite", sprite_name)) {
+        SpriteManager::current()->preload(sprite_name);
+      }
+      preload_sprites(object.get_sexp());
+
+      if (iter.get_key() == "background") {
+        for(const auto& key : { "image", "image-top", "image-bottom" }) {
+          std::string image;
+          if (object.get(key, image)) {
+            TextureManager::current()->preload(image);
+          }
+        }
+      }
+    } catch(const std::exception&) {
+    }
+  }
+}
+
 SectorParser::SectorParser(Sector& sector) :
   m_sector(sector)
 {
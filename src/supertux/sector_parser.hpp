@@ -33,6 +33,10 @@ public:
   static std::unique_ptr<Sector> from_reader_old_format(Level& level, const ReaderMapping& sector);
   static std::unique_ptr<Sector> from_nothing(Level& level);
 
+  /** Starts decoding the sprites and backgrounds used by the objects
+      of the sector, before they get constructed */
+  static void preload(const ReaderMapping& sector);
+
 private:
   SectorParser(Sector& sector);
 
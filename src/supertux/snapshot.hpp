@@ -0,0 +1,120 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_SNAPSHOT_HPP
+#define HEADER_SUPERTUX_SUPERTUX_SNAPSHOT_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/** Serializes the runtime state of GameObjects into a flat byte
+    buffer, see GameObject::backup(). Only plain values are written,
+    there is no versioning as snapshots never outlive the session. */
+class SnapshotWriter final
+{
+public:
+  SnapshotWriter() : m_data() {}
+
+  template<typename T>
+  void write(const T& value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable types can be written to a snapshot");
+    const auto* p = reinterpret_cast<const uint8_t*>(&value);
+    m_data.insert(m_data.end(), p, p + sizeof(T));
+  }
+
+  void write(const std::string& value)
+  {
+    write(static_cast<uint32_t>(value.size()));
+    m_data.insert(m_data.end(), value.begin(), value.end());
+  }
+
+  void write_bytes(const uint8_t* data, size_t size)
+  {
+    m_data.insert(m_data.end(), data, data + size);
+  }
+
+  size_t size() const { return m_data.size(); }
+  const std::vector<uint8_t>& get_data() const { return m_data; }
+  std::vector<uint8_t> release() { return std::move(m_data); }
+
+private:
+  std::vector<uint8_t> m_data;
+
+private:
+  SnapshotWriter(const SnapshotWriter&) = delete;
+  SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+};
+
+/** Reads back what a SnapshotWriter produced, the read calls have to
+    mirror the write calls exactly. */
+class SnapshotReader final
+{
+public:
+  SnapshotReader(const uint8_t* data, size_t size) :
+    m_data(data),
+    m_size(size),
+    m_pos(0)
+  {}
+
+  template<typename T>
+  void read(T& value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable types can be read from a snapshot");
+    memcpy(&value, take(sizeof(T)), sizeof(T));
+  }
+
+  void read(std::string& value)
+  {
+    uint32_t size;
+    read(size);
+    const auto* p = reinterpret_cast<const char*>(take(size));
+    value.assign(p, size);
+  }
+
+  const uint8_t* read_bytes(size_t size) { return take(size); }
+
+  bool eof() const { return m_pos == m_size; }
+
+private:
+  const uint8_t* take(size_t size)
+  {
+    if (size > m_size - m_pos)
+      throw std::runtime_error("snapshot: read past end of data");
+    const uint8_t* p = m_data + m_pos;
+    m_pos += size;
+    return p;
+  }
+
+private:
+  const uint8_t* m_data;
+  size_t m_size;
+  size_t m_pos;
+
+private:
+  SnapshotReader(const SnapshotReader&) = delete;
+  SnapshotReader& operator=(const SnapshotReader&) = delete;
+};
+
+#endif
+
+/* EOF */
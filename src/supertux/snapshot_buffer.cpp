@@ -0,0 +1,208 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/snapshot_buffer.hpp"
+
+#include <assert.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+void write_varint(std::vector<uint8_t>& out, size_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+size_t read_varint(const std::vector<uint8_t>& data, size_t& pos)
+{
+  size_t value = 0;
+  for (int shift = 0; ; shift += 7)
+  {
+    if (pos >= data.size() || shift >= 64)
+      throw std::runtime_error("SnapshotBuffer: corrupt delta");
+    const uint8_t byte = data[pos++];
+    value |= static_cast<size_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return value;
+  }
+}
+
+uint8_t byte_at(const std::vector<uint8_t>& data, size_t i)
+{
+  return i < data.size() ? data[i] : 0;
+}
+
+} // namespace
+
+SnapshotBuffer::SnapshotBuffer(size_t capacity, size_t keyframe_interval) :
+  m_capacity(std::max<size_t>(capacity, 1)),
+  m_keyframe_interval(std::max<size_t>(std::min(keyframe_interval, m_capacity), 1)),
+  m_frames(),
+  m_group_size(0),
+  m_memory_usage(0)
+{
+}
+
+void
+SnapshotBuffer::push(const std::vector<uint8_t>& state)
+{
+  Frame frame;
+  frame.size = state.size();
+  if (m_group_size == 0 || m_group_size >= m_keyframe_interval)
+  {
+    frame.keyframe = true;
+    frame.data = state;
+    m_group_size = 1;
+  }
+  else
+  {
+    const Frame& keyframe = m_frames[m_frames.size() - m_group_size];
+    assert(keyframe.keyframe);
+    frame.keyframe = false;
+    frame.data = encode_delta(keyframe.data, state);
+    m_group_size += 1;
+  }
+
+  m_memory_usage += frame.data.size();
+  m_frames.push_back(std::move(frame));
+
+  while (m_frames.size() > m_capacity)
+  {
+    // deltas can't outlive their keyframe, so the whole group goes
+    do {
+      pop_front();
+    } while (!m_frames.empty() && !m_frames.front().keyframe);
+  }
+
+  if (m_frames.empty())
+    m_group_size = 0;
+}
+
+std::vector<uint8_t>
+SnapshotBuffer::get(size_t age) const
+{
+  if (age >= m_frames.size())
+    throw std::out_of_range("SnapshotBuffer: no such snapshot");
+
+  size_t idx = m_frames.size() - 1 - age;
+  const Frame& frame = m_frames[idx];
+  if (frame.keyframe)
+    return frame.data;
+
+  while (!m_frames[idx].keyframe)
+  {
+    assert(idx > 0);
+    idx -= 1;
+  }
+  return decode_delta(m_frames[idx].data, frame);
+}
+
+void
+SnapshotBuffer::drop_newest(size_t count)
+{
+  count = std::min(count, m_frames.size());
+  for (size_t i = 0; i < count; ++i)
+    pop_back();
+
+  m_group_size = 0;
+  for (auto it = m_frames.rbegin(); it != m_frames.rend(); ++it)
+  {
+    m_group_size += 1;
+    if (it->keyframe)
+      return;
+  }
+  m_group_size = 0;
+}
+
+void
+SnapshotBuffer::clear()
+{
+  m_frames.clear();
+  m_group_size = 0;
+  m_memory_usage = 0;
+}
+
+void
+SnapshotBuffer::pop_front()
+{
+  m_memory_usage -= m_frames.front().data.size();
+  m_frames.pop_front();
+}
+
+void
+SnapshotBuffer::pop_back()
+{
+  m_memory_usage -= m_frames.back().data.size();
+  m_frames.pop_back();
+}
+
+std::vector<uint8_t>
+SnapshotBuffer::encode_delta(const std::vector<uint8_t>& base,
+                             const std::vector<uint8_t>& state)
+{
+  // sequence of (unchanged run, changed run, xor bytes of changed run)
+  std::vector<uint8_t> out;
+  size_t i = 0;
+  while (i < state.size())
+  {
+    const size_t same_start = i;
+    while (i < state.size() && state[i] == byte_at(base, i))
+      ++i;
+    if (i == state.size())
+      break;
+
+    const size_t diff_start = i;
+    while (i < state.size() && state[i] != byte_at(base, i))
+      ++i;
+
+    write_varint(out, diff_start - same_start);
+    write_varint(out, i - diff_start);
+    for (size_t j = diff_start; j < i; ++j)
+      out.push_back(static_cast<uint8_t>(state[j] ^ byte_at(base, j)));
+  }
+  return out;
+}
+
+std::vector<uint8_t>
+SnapshotBuffer::decode_delta(const std::vector<uint8_t>& base,
+                             const Frame& frame)
+{
+  std::vector<uint8_t> out(frame.size, 0);
+  std::copy_n(base.begin(), std::min(base.size(), frame.size), out.begin());
+
+  size_t pos = 0;
+  size_t i = 0;
+  while (pos < frame.data.size())
+  {
+    i += read_varint(frame.data, pos);
+    const size_t count = read_varint(frame.data, pos);
+    if (i + count > out.size() || pos + count > frame.data.size())
+      throw std::runtime_error("SnapshotBuffer: corrupt delta");
+    for (size_t j = 0; j < count; ++j)
+      out[i + j] ^= frame.data[pos + j];
+    i += count;
+    pos += count;
+  }
+  return out;
+}
+
+/* EOF */
@@ -0,0 +1,86 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_SNAPSHOT_BUFFER_HPP
+#define HEADER_SUPERTUX_SUPERTUX_SNAPSHOT_BUFFER_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+/** Ring buffer of serialized sector states. Every keyframe_interval
+    frames a full copy is stored, the frames in between only store the
+    bytes that differ from their keyframe, which is small as most
+    objects don't change between two captures. Once the buffer is
+    full the oldest keyframe group is dropped. */
+class SnapshotBuffer final
+{
+public:
+  SnapshotBuffer(size_t capacity, size_t keyframe_interval);
+
+  void push(const std::vector<uint8_t>& state);
+
+  /** Reconstructs a stored state, age 0 is the most recent one */
+  std::vector<uint8_t> get(size_t age) const;
+
+  /** Forgets the count most recent states, used after rewinding so
+      that the next push continues from the restored state */
+  void drop_newest(size_t count);
+
+  void clear();
+
+  size_t size() const { return m_frames.size(); }
+  bool empty() const { return m_frames.empty(); }
+
+  /** Bytes used by the encoded frames */
+  size_t get_memory_usage() const { return m_memory_usage; }
+
+private:
+  struct Frame
+  {
+    bool keyframe;
+    /** size of the decoded state */
+    size_t size;
+    /** full state for keyframes, encoded xor delta otherwise */
+    std::vector<uint8_t> data;
+  };
+
+  void pop_front();
+  void pop_back();
+
+  static std::vector<uint8_t> encode_delta(const std::vector<uint8_t>& base,
+                                           const std::vector<uint8_t>& state);
+  static std::vector<uint8_t> decode_delta(const std::vector<uint8_t>& base,
+                                           const Frame& frame);
+
+private:
+  size_t m_capacity;
+  size_t m_keyframe_interval;
+  std::deque<Frame> m_frames;
+
+  /** frames pushed since the last keyframe, including the keyframe */
+  size_t m_group_size;
+  size_t m_memory_usage;
+
+private:
+  SnapshotBuffer(const SnapshotBuffer&) = delete;
+  SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,246 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/static_lightmap.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+#include "object/static_light_source.hpp"
+#include "util/obstackpp.hpp"
+#include "video/compositor.hpp"
+#include "video/drawing_context.hpp"
+#include "video/painter.hpp"
+#include "video/renderer.hpp"
+#include "video/surface.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+bool same_rect(const Rectf& lhs, const Rectf& rhs)
+{
+  return lhs.p1 == rhs.p1 && lhs.p2 == rhs.p2;
+}
+
+Rectf get_chunk_rect(int x, int y)
+{
+  return Rectf(Vector(static_cast<float>(x * StaticLightmap::s_chunk_size),
+                      static_cast<float>(y * StaticLightmap::s_chunk_size)),
+               Sizef(static_cast<float>(StaticLightmap::s_chunk_size),
+                     static_cast<float>(StaticLightmap::s_chunk_size)));
+}
+
+int get_chunk_index(float v)
+{
+  return static_cast<int>(floorf(v / static_cast<float>(StaticLightmap::s_chunk_size)));
+}
+
+} // namespace
+
+StaticLightmap::StaticLightmap() :
+  m_lights(),
+  m_chunks(),
+  m_downscale(0)
+{
+}
+
+StaticLightmap::~StaticLightmap()
+{
+}
+
+void
+StaticLightmap::add(StaticLightSource& source)
+{
+  m_lights.push_back({ &source, source.get_light_bbox(), false });
+}
+
+void
+StaticLightmap::remove(StaticLightSource& source)
+{
+  auto it = std::find_if(m_lights.begin(), m_lights.end(),
+                         [&source](const Light& light) {
+                           return light.source == &source;
+                         });
+  if (it == m_lights.end())
+    return;
+
+  if (it->baked)
+    invalidate_region(it->bbox);
+
+  source.set_light_baked(false);
+  m_lights.erase(it);
+}
+
+void
+StaticLightmap::invalidate()
+{
+  m_chunks.clear();
+
+  for (auto& light : m_lights)
+  {
+    light.baked = false;
+    light.source->set_light_baked(false);
+  }
+}
+
+void
+StaticLightmap::draw(DrawingContext& context)
+{
+  if (!context.use_lightmap() || !Compositor::s_render_lighting)
+  {
+    // the lightmap isn't rendered, so there is nothing to bake, but
+    // the lights have to draw themselves once the lightmap returns
+    invalidate();
+    return;
+  }
+
+  const int downscale = VideoSystem::get_lightmap_downscale(VideoSystem::current()->get_viewport());
+  if (downscale != m_downscale)
+  {
+    invalidate();
+    m_downscale = downscale;
+  }
+
+  update_lights();
+
+  for (auto it = m_chunks.begin(); it != m_chunks.end();)
+  {
+    if (it->second.dirty)
+    {
+      bake_chunk(it->first, it->second);
+    }
+
+    if (!it->second.surface)
+    {
+      it = m_chunks.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  for (auto& light : m_lights)
+  {
+    light.source->set_light_baked(light.baked);
+  }
+
+  const Rectf cliprect = context.get_cliprect();
+  for (int y = get_chunk_index(cliprect.get_top()); y <= get_chunk_index(cliprect.get_bottom()); ++y)
+  {
+    for (int x = get_chunk_index(cliprect.get_left()); x <= get_chunk_index(cliprect.get_right()); ++x)
+    {
+      auto it = m_chunks.find(ChunkPos(x, y));
+      if (it != m_chunks.end())
+      {
+        context.light().draw_surface_scaled(it->second.surface, get_chunk_rect(x, y), 0,
+                                            PaintStyle().set_blend(Blend::ADD));
+      }
+    }
+  }
+}
+
+void
+StaticLightmap::update_lights()
+{
+  for (auto& light : m_lights)
+  {
+    const bool is_static = light.source->is_light_static() && !light.source->is_light_changed();
+    const Rectf bbox = light.source->get_light_bbox();
+
+    if (light.baked)
+    {
+      if (!is_static || !same_rect(bbox, light.bbox))
+      {
+        invalidate_region(light.bbox);
+        light.baked = false;
+      }
+    }
+    else if (is_static && same_rect(bbox, light.bbox))
+    {
+      invalidate_region(bbox);
+      light.baked = true;
+    }
+
+    light.bbox = bbox;
+    light.source->clear_light_changed();
+  }
+}
+
+void
+StaticLightmap::invalidate_region(const Rectf& rect)
+{
+  for (int y = get_chunk_index(rect.get_top()); y <= get_chunk_index(rect.get_bottom()); ++y)
+  {
+    for (int x = get_chunk_index(rect.get_left()); x <= get_chunk_index(rect.get_right()); ++x)
+    {
+      m_chunks[ChunkPos(x, y)].dirty = true;
+    }
+  }
+}
+
+void
+StaticLightmap::bake_chunk(const ChunkPos& pos, Chunk& chunk)
+{
+  chunk.dirty = false;
+
+  const Rectf chunk_rect = get_chunk_rect(pos.first, pos.second);
+
+  std::vector<StaticLightSource*> sources;
+  for (const auto& light : m_lights)
+  {
+    if (light.baked && chunk_rect.contains(light.bbox))
+    {
+      sources.push_back(light.source);
+    }
+  }
+
+  if (sources.empty())
+  {
+    chunk.surface.reset();
+    chunk.renderer.reset();
+    return;
+  }
+
+  VideoSystem& video_system = *VideoSystem::current();
+
+  if (!chunk.renderer)
+  {
+    chunk.renderer = video_system.new_texture_renderer(Size(s_chunk_size, s_chunk_size), m_downscale);
+  }
+
+  obstack obst;
+  obstack_init(&obst);
+  {
+    DrawingContext context(video_system, obst, false);
+    context.set_translation(chunk_rect.p1);
+
+    for (auto* source : sources)
+    {
+      source->draw_light(context.light());
+    }
+
+    chunk.renderer->start_draw();
+    chunk.renderer->get_painter().clear(Color::BLACK);
+    context.light().render(*chunk.renderer, Canvas::ALL);
+    chunk.renderer->end_draw();
+  }
+  obstack_free(&obst, nullptr);
+
+  chunk.surface = Surface::from_texture(chunk.renderer->get_texture());
+}
+
+/* EOF */
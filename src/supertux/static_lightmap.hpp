@@ -0,0 +1,98 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_STATIC_LIGHTMAP_HPP
+#define HEADER_SUPERTUX_SUPERTUX_STATIC_LIGHTMAP_HPP
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "video/surface_ptr.hpp"
+
+class DrawingContext;
+class Renderer;
+class StaticLightSource;
+
+/** Caches the contribution of lights that don't change from frame to
+    frame in chunk textures. Instead of redrawing every static light
+    into the lightmap each frame, only the visible chunks are drawn.
+    Chunks are rebaked when a light in them changes. */
+class StaticLightmap final
+{
+public:
+  /** Size of a chunk in sector coordinates */
+  static const int s_chunk_size = 512;
+
+public:
+  StaticLightmap();
+  ~StaticLightmap();
+
+  void add(StaticLightSource& source);
+  void remove(StaticLightSource& source);
+
+  /** Releases all chunks, the lights will draw themselves again
+      until the next call to draw() bakes them */
+  void invalidate();
+
+  /** Bakes chunks whose lights have changed and draws the chunks
+      visible in the context into its lightmap */
+  void draw(DrawingContext& context);
+
+private:
+  typedef std::pair<int, int> ChunkPos;
+
+  struct Light
+  {
+    StaticLightSource* source;
+
+    /** Area covered by the light in the last frame, a light is only
+        baked once it stayed in place for a frame */
+    Rectf bbox;
+
+    bool baked;
+  };
+
+  struct Chunk
+  {
+    std::unique_ptr<Renderer> renderer;
+    SurfacePtr surface;
+    bool dirty;
+  };
+
+private:
+  void update_lights();
+  void invalidate_region(const Rectf& rect);
+  void bake_chunk(const ChunkPos& pos, Chunk& chunk);
+
+private:
+  std::vector<Light> m_lights;
+  std::map<ChunkPos, Chunk> m_chunks;
+
+  /** Downscale the chunks have been rendered with, chunks are
+      rebaked when the lightmap resolution changes */
+  int m_downscale;
+
+private:
+  StaticLightmap(const StaticLightmap&) = delete;
+  StaticLightmap& operator=(const StaticLightmap&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -18,12 +18,19 @@
 
 #include "supertux/tile.hpp"
 
+#include <sstream>
+
 #include "math/aatriangle.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/reader_object.hpp"
+#include "util/string_util.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
+#include "video/texture_manager.hpp"
 
 bool Tile::draw_editor_images = false;
 
@@ -44,9 +51,34 @@ bool is_below_line (float l_x, float l_y, float m,
 
 } // namespace
 
+SurfacePtr
+TileImageSpec::load() const
+{
+  SurfacePtr result;
+  if (surface.empty())
+  {
+    result = Surface::from_file(file, rect);
+  }
+  else
+  {
+    std::istringstream in(surface);
+    auto doc = ReaderDocument::from_stream(in, file);
+    result = Surface::from_reader(doc.get_root().get_mapping(), rect);
+  }
+
+  if (region)
+  {
+    result = result->region(*region);
+  }
+  return result;
+}
+
 Tile::Tile() :
+  m_image_specs(),
+  m_editor_image_specs(),
   m_images(),
   m_editor_images(),
+  m_images_loaded(true),
   m_attributes(0),
   m_data(0),
   m_fps(1),
@@ -56,12 +88,15 @@ Tile::Tile() :
 {
 }
 
-Tile::Tile(const std::vector<SurfacePtr>& images,
-           const std::vector<SurfacePtr>& editor_images,
+Tile::Tile(const std::vector<TileImageSpec>& images,
+           const std::vector<TileImageSpec>& editor_images,
            uint32_t attributes_, uint32_t data_, float fps_, const std::string& obj_name,
            const std::string& obj_data, bool deprecated) :
-  m_images(images),
-  m_editor_images(editor_images),
+  m_image_specs(images),
+  m_editor_image_specs(editor_images),
+  m_images(),
+  m_editor_images(),
+  m_images_loaded(images.empty() && editor_images.empty()),
   m_attributes(attributes_),
   m_data(data_),
   m_fps(fps_),
@@ -72,9 +107,61 @@ Tile::Tile(const std::vector<SurfacePtr>& images,
   correct_attributes();
 }
 
+void
+Tile::load_images() const
+{
+  if (m_images_loaded)
+    return;
+
+  // a tile with only some of its frames would animate wrongly
+  std::vector<SurfacePtr> images;
+  std::vector<SurfacePtr> editor_images;
+  try
+  {
+    for(const auto& spec : m_image_specs)
+    {
+      images.push_back(spec.load());
+    }
+
+    for(const auto& spec : m_editor_image_specs)
+    {
+      editor_images.push_back(spec.load());
+    }
+
+    m_images = std::move(images);
+    m_editor_images = std::move(editor_images);
+  }
+  catch(const std::exception& e)
+  {
+    log_warning << "Couldn't load tile image: " << e.what() << std::endl;
+  }
+
+  // a broken tile isn't tried again on every draw
+  m_images_loaded = true;
+}
+
+void
+Tile::preload() const
+{
+  if (m_images_loaded)
+    return;
+
+  for(const auto& spec : m_image_specs)
+  {
+    if (spec.surface.empty() && !StringUtil::has_suffix(spec.file, ".surface"))
+    {
+      TextureManager::current()->preload(spec.file);
+    }
+  }
+}
+
 void
 Tile::draw(Canvas& canvas, const Vector& pos, int z_pos, Color color) const
 {
+  if(!m_images_loaded) {
+    load_images();
+  }
+
   if(draw_editor_images) {
     if(m_editor_images.size() > 1) {
       size_t frame = size_t(g_game_time * m_fps) % m_editor_images.size();
@@ -97,6 +184,10 @@ Tile::draw(Canvas& canvas, const Vector& pos, int z_pos, Color color) const
 SurfacePtr
 Tile::get_current_surface() const
 {
+  if(!m_images_loaded) {
+    load_images();
+  }
+
   if(m_images.size() > 1) {
     size_t frame = size_t(g_game_time * m_fps) % m_images.size();
     return m_images[frame];
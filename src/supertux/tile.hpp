@@ -19,9 +19,12 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_TILE_HPP
 #define HEADER_SUPERTUX_SUPERTUX_TILE_HPP
 
+#include <string>
 #include <vector>
 #include <stdint.h>
+#include <boost/optional.hpp>
 
+#include "math/rect.hpp"
 #include "math/rectf.hpp"
 #include "video/color.hpp"
 #include "video/surface_ptr.hpp"
@@ -29,6 +32,37 @@
 class Canvas;
 class DrawingContext;
 
+/** Where a tile image comes from, the Surface is only created when a
+    tilemap using the tile gets constructed, or on the first draw */
+class TileImageSpec final
+{
+public:
+  TileImageSpec() :
+    file(),
+    surface(),
+    rect(),
+    region()
+  {}
+
+  /** Creates the Surface, this loads the texture if it isn't in use yet */
+  SurfacePtr load() const;
+
+public:
+  /** image file, or for an inline (surface ...) the tileset file
+      that its paths are relative to */
+  std::string file;
+
+  /** the inline (surface ...) as s-expression, empty otherwise */
+  std::string surface;
+
+  /** part of the image that the texture is created from */
+  boost::optional<Rect> rect;
+
+  /** part of the texture that is shown, used for tiles that share
+      one surface */
+  boost::optional<Rect> region;
+};
+
 class Tile final
 {
 public:
@@ -94,8 +128,13 @@ public:
   };
 
 private:
-  std::vector<SurfacePtr> m_images;
-  std::vector<SurfacePtr> m_editor_images;
+  std::vector<TileImageSpec> m_image_specs;
+  std::vector<TileImageSpec> m_editor_image_specs;
+
+  /** created from the specs by load_images() */
+  mutable std::vector<SurfacePtr> m_images;
+  mutable std::vector<SurfacePtr> m_editor_images;
+  mutable bool m_images_loaded;
 
   /// tile attributes
   uint32_t m_attributes;
@@ -112,8 +151,8 @@ private:
 
 public:
   Tile();
-  Tile(const std::vector<SurfacePtr>& images,
-       const std::vector<SurfacePtr>& editor_images,
+  Tile(const std::vector<TileImageSpec>& images,
+       const std::vector<TileImageSpec>& editor_images,
        uint32_t attributes, uint32_t data, float fps, const std::string& obj_name = "",
        const std::string& obj_data = "", bool deprecated = false);
 
@@ -122,6 +161,26 @@ public:
 
   SurfacePtr get_current_surface() const;
 
+  /** Queues the image files for decoding in the background, so that
+      the first draw() doesn't have to wait for them */
+  void preload() const;
+
+  /** Creates the surfaces from the image specs, unless that happened
+      already; a tile whose images fail to load stays invisible */
+  void load_images() const;
+
+  bool has_loaded_images() const
+  { return m_images_loaded; }
+
+  const std::vector<TileImageSpec>& get_image_specs() const
+  { return m_image_specs; }
+
+  const std::vector<TileImageSpec>& get_editor_image_specs() const
+  { return m_editor_image_specs; }
+
+  float get_fps() const
+  { return m_fps; }
+
   uint32_t get_attributes() const
   { return m_attributes; }
 
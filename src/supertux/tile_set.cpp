@@ -16,9 +16,14 @@
 
 #include "supertux/tile_set.hpp"
 
+#include <chrono>
+
 #include "editor/editor.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/tile.hpp"
+#include "supertux/tile_set_cache.hpp"
 #include "supertux/tile_set_parser.hpp"
 #include "util/gettext.hpp"
 #include "util/log.hpp"
@@ -35,10 +40,30 @@ Tilegroup::Tilegroup() :
 std::unique_ptr<TileSet>
 TileSet::from_file(const std::string& filename)
 {
-  auto tileset = std::make_unique<TileSet>();
+  const auto start = std::chrono::steady_clock::now();
+
+  TileSetCache cache("cache/tilesets");
+  auto tileset = cache.load(filename);
+  const bool from_cache = static_cast<bool>(tileset);
+  if (!tileset)
+  {
+    tileset = std::make_unique<TileSet>();
+
+    TileSetParser parser(*tileset, filename);
+    parser.parse();
 
-  TileSetParser parser(*tileset, filename);
-  parser.parse();
+    cache.store(filename, *tileset);
+  }
+
+  if(g_config->developer_mode)
+  {
+    tileset->add_unassigned_tilegroup();
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  log_info << "loaded tileset " << filename << (from_cache ? " from the index cache" : "")
+           << " in " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+           << " ms" << std::endl;
 
   tileset->print_debug_info(filename);
 
@@ -84,6 +109,16 @@ TileSet::get(const uint32_t id) const
   }
 }
 
+const Tile*
+TileSet::find(const uint32_t id) const
+{
+  if (id >= m_tiles.size()) {
+    return nullptr;
+  } else {
+    return m_tiles[id].get();
+  }
+}
+
 void
 TileSet::add_unassigned_tilegroup()
 {
@@ -57,6 +57,9 @@ public:
 
   const Tile& get(const uint32_t id) const;
 
+  /** Returns nullptr for ids that have no tile, unlike get() */
+  const Tile* find(const uint32_t id) const;
+
   uint32_t get_max_tileid() const {
     return static_cast<uint32_t>(m_tiles.size());
   }
@@ -0,0 +1,290 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/tile_set_cache.hpp"
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "physfs/physfs_cache_file.hpp"
+#include "supertux/snapshot.hpp"
+#include "supertux/tile.hpp"
+#include "supertux/tile_set.hpp"
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'T', 'S' };
+const uint32_t VERSION = 1;
+
+struct Header
+{
+  char magic[4];
+  uint32_t version;
+  int64_t modtime;
+  int64_t filesize;
+  uint32_t path_length;
+};
+
+// the header is written as is, a change of its layout needs a new VERSION
+static_assert(sizeof(Header) == 32, "cache header layout changed");
+
+void write_rect(SnapshotWriter& writer, const boost::optional<Rect>& rect)
+{
+  writer.write(static_cast<uint8_t>(rect ? 1 : 0));
+  if (rect)
+  {
+    writer.write(static_cast<int32_t>(rect->left));
+    writer.write(static_cast<int32_t>(rect->top));
+    writer.write(static_cast<int32_t>(rect->right));
+    writer.write(static_cast<int32_t>(rect->bottom));
+  }
+}
+
+void read_rect(SnapshotReader& reader, boost::optional<Rect>& rect)
+{
+  uint8_t has_rect;
+  reader.read(has_rect);
+  if (has_rect)
+  {
+    int32_t left, top, right, bottom;
+    reader.read(left);
+    reader.read(top);
+    reader.read(right);
+    reader.read(bottom);
+    rect = Rect(left, top, right, bottom);
+  }
+}
+
+void write_specs(SnapshotWriter& writer, const std::vector<TileImageSpec>& specs)
+{
+  writer.write(static_cast<uint32_t>(specs.size()));
+  for(const auto& spec : specs)
+  {
+    writer.write(spec.file);
+    writer.write(spec.surface);
+    write_rect(writer, spec.rect);
+    write_rect(writer, spec.region);
+  }
+}
+
+std::vector<TileImageSpec> read_specs(SnapshotReader& reader)
+{
+  uint32_t count;
+  reader.read(count);
+
+  std::vector<TileImageSpec> specs;
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    TileImageSpec spec;
+    reader.read(spec.file);
+    reader.read(spec.surface);
+    read_rect(reader, spec.rect);
+    read_rect(reader, spec.region);
+    specs.push_back(spec);
+  }
+  return specs;
+}
+
+} // namespace
+
+TileSetCache::TileSetCache(const std::string& directory) :
+  m_directory(directory)
+{
+  PHYSFS_mkdir(m_directory.c_str());
+}
+
+std::string
+TileSetCache::get_cache_filename(const std::string& filename) const
+{
+  // collisions are caught by comparing the path stored in the header
+  std::ostringstream out;
+  out << m_directory << "/" << std::hex << std::setw(16) << std::setfill('0')
+      << std::hash<std::string>()(filename) << ".tsi";
+  return out.str();
+}
+
+std::unique_ptr<TileSet>
+TileSetCache::load(const std::string& filename) const
+{
+  PHYSFS_Stat statbuf;
+  if (!PhysFSCacheFile::stat_source(filename, statbuf))
+    return {};
+
+  const std::string cache_filename = get_cache_filename(filename);
+  if (!PHYSFS_exists(cache_filename.c_str()))
+    return {};
+
+  PHYSFSFilePtr file = PhysFSCacheFile::open_read(cache_filename);
+  if (!file)
+    return {};
+
+  Header header;
+  if (PHYSFS_readBytes(file.get(), &header, sizeof(header)) != sizeof(header) ||
+      memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION ||
+      header.modtime != statbuf.modtime ||
+      header.filesize != statbuf.filesize ||
+      header.path_length != filename.size())
+  {
+    return {};
+  }
+
+  std::string path(header.path_length, '\0');
+  if (PHYSFS_readBytes(file.get(), &path[0], path.size()) != static_cast<PHYSFS_sint64>(path.size()) ||
+      path != filename)
+  {
+    return {};
+  }
+
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file.get());
+  const PHYSFS_sint64 offset = PHYSFS_tell(file.get());
+  if (length < 0 || offset < 0 || length < offset)
+    return {};
+
+  std::vector<uint8_t> data(static_cast<size_t>(length - offset));
+  if (PHYSFS_readBytes(file.get(), data.data(), data.size()) != static_cast<PHYSFS_sint64>(data.size()))
+    return {};
+
+  auto tileset = std::make_unique<TileSet>();
+  try
+  {
+    SnapshotReader reader(data.data(), data.size());
+
+    uint32_t tile_count;
+    reader.read(tile_count);
+    for(uint32_t i = 0; i < tile_count; ++i)
+    {
+      uint32_t id, attributes;
+      int32_t tile_data;
+      float fps;
+      std::string object_name, object_data;
+      uint8_t deprecated;
+
+      reader.read(id);
+      reader.read(attributes);
+      reader.read(tile_data);
+      reader.read(fps);
+      reader.read(object_name);
+      reader.read(object_data);
+      reader.read(deprecated);
+      auto images = read_specs(reader);
+      auto editor_images = read_specs(reader);
+
+      tileset->add_tile(id, std::make_unique<Tile>(images, editor_images,
+                                                   attributes, static_cast<uint32_t>(tile_data), fps,
+                                                   object_name, object_data, deprecated != 0));
+    }
+
+    uint32_t group_count;
+    reader.read(group_count);
+    for(uint32_t i = 0; i < group_count; ++i)
+    {
+      Tilegroup tilegroup;
+      uint8_t developers_group;
+      uint32_t size;
+      reader.read(tilegroup.name);
+      reader.read(developers_group);
+      reader.read(size);
+      tilegroup.developers_group = developers_group != 0;
+      for(uint32_t j = 0; j < size; ++j)
+      {
+        int32_t id;
+        reader.read(id);
+        tilegroup.tiles.push_back(id);
+      }
+      tileset->add_tilegroup(tilegroup);
+    }
+
+    if (!reader.eof())
+      return {};
+  }
+  catch(const std::exception&)
+  {
+    return {};
+  }
+
+  return tileset;
+}
+
+void
+TileSetCache::store(const std::string& filename, const TileSet& tileset) const
+{
+  PHYSFS_Stat statbuf;
+  if (!PhysFSCacheFile::stat_source(filename, statbuf))
+    return;
+
+  SnapshotWriter writer;
+
+  // id 0 is the empty tile every TileSet starts with
+  std::vector<uint32_t> ids;
+  for(uint32_t id = 1; id < tileset.get_max_tileid(); ++id)
+  {
+    if (tileset.find(id))
+      ids.push_back(id);
+  }
+
+  writer.write(static_cast<uint32_t>(ids.size()));
+  for(const auto id : ids)
+  {
+    const Tile& tile = *tileset.find(id);
+    writer.write(id);
+    writer.write(tile.get_attributes());
+    writer.write(static_cast<int32_t>(tile.get_data()));
+    writer.write(tile.get_fps());
+    writer.write(tile.get_object_name());
+    writer.write(tile.get_object_data());
+    writer.write(static_cast<uint8_t>(tile.is_deprecated() ? 1 : 0));
+    write_specs(writer, tile.get_image_specs());
+    write_specs(writer, tile.get_editor_image_specs());
+  }
+
+  const auto& tilegroups = tileset.get_tilegroups();
+  writer.write(static_cast<uint32_t>(tilegroups.size()));
+  for(const auto& tilegroup : tilegroups)
+  {
+    writer.write(tilegroup.name);
+    writer.write(static_cast<uint8_t>(tilegroup.developers_group ? 1 : 0));
+    writer.write(static_cast<uint32_t>(tilegroup.tiles.size()));
+    for(const auto id : tilegroup.tiles)
+    {
+      writer.write(static_cast<int32_t>(id));
+    }
+  }
+
+  PHYSFSFilePtr file = PhysFSCacheFile::open_write(get_cache_filename(filename));
+  if (!file)
+    return;
+
+  // the padding bytes end up in the file as well
+  Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.modtime = statbuf.modtime;
+  header.filesize = statbuf.filesize;
+  header.path_length = static_cast<uint32_t>(filename.size());
+
+  PHYSFS_writeBytes(file.get(), &header, sizeof(header));
+  PHYSFS_writeBytes(file.get(), filename.data(), filename.size());
+  PHYSFS_writeBytes(file.get(), writer.get_data().data(), writer.size());
+}
+
+/* EOF */
@@ -0,0 +1,57 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_TILE_SET_CACHE_HPP
+#define HEADER_SUPERTUX_SUPERTUX_TILE_SET_CACHE_HPP
+
+#include <memory>
+#include <string>
+
+class TileSet;
+
+/** Keeps a binary index of parsed tilesets in the user directory,
+    with the ids, attributes, data, fps and image specs of every tile
+    plus the tilegroups, so that the next start doesn't have to go
+    through the s-expression of the whole .strf file. Entries are
+    keyed by path, file size and modification time of the tileset. */
+class TileSetCache final
+{
+public:
+  TileSetCache(const std::string& directory);
+
+  /** Returns the cached tileset, or nullptr when there is no valid
+      entry for \a filename */
+  std::unique_ptr<TileSet> load(const std::string& filename) const;
+
+  /** Writes \a tileset as the cache entry for \a filename, failures
+      are silently ignored, as the cache is only an optimization */
+  void store(const std::string& filename, const TileSet& tileset) const;
+
+private:
+  std::string get_cache_filename(const std::string& filename) const;
+
+private:
+  std::string m_directory;
+
+private:
+  TileSetCache(const TileSetCache&) = delete;
+  TileSetCache& operator=(const TileSetCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -21,14 +21,11 @@
 #include <sexp/value.hpp>
 #include <sexp/io.hpp>
 
-#include "supertux/gameconfig.hpp"
-#include "supertux/globals.hpp"
 #include "supertux/tile_set.hpp"
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/file_system.hpp"
-#include "video/surface.hpp"
 
 TileSetParser::TileSetParser(TileSet& tileset, const std::string& filename) :
   m_tileset(tileset),
@@ -76,10 +73,6 @@ TileSetParser::parse()
       log_warning << "Unknown symbol '" << iter.get_key() << "' in tileset file" << std::endl;
     }
   }
-  if(g_config->developer_mode)
-  {
-    m_tileset.add_unassigned_tilegroup();
-  }
 }
 
 void
@@ -142,13 +135,13 @@ TileSetParser::parse_tile(const ReaderMapping& reader)
     attributes |= Tile::SOLID | Tile::SLOPE;
   }
 
-  std::vector<SurfacePtr> editor_surfaces;
+  std::vector<TileImageSpec> editor_surfaces;
   boost::optional<ReaderMapping> editor_images_mapping;
   if(reader.get("editor-images", editor_images_mapping)) {
     editor_surfaces = parse_imagespecs(*editor_images_mapping);
   }
 
-  std::vector<SurfacePtr> surfaces;
+  std::vector<TileImageSpec> surfaces;
   boost::optional<ReaderMapping> images_mapping;
   if(reader.get("images", images_mapping)) {
     surfaces = parse_imagespecs(*images_mapping);
@@ -238,13 +231,13 @@ TileSetParser::parse_tiles(const ReaderMapping& reader)
   {
     if (shared_surface)
     {
-      std::vector<SurfacePtr> editor_surfaces;
+      std::vector<TileImageSpec> editor_surfaces;
       boost::optional<ReaderMapping> editor_surfaces_mapping;
       if(reader.get("editor-images", editor_surfaces_mapping)) {
         editor_surfaces = parse_imagespecs(*editor_surfaces_mapping);
       }
 
-      std::vector<SurfacePtr> surfaces;
+      std::vector<TileImageSpec> surfaces;
       boost::optional<ReaderMapping> surfaces_mapping;
       if(reader.get("image", surfaces_mapping) ||
          reader.get("images", surfaces_mapping)) {
@@ -258,17 +251,17 @@ TileSetParser::parse_tiles(const ReaderMapping& reader)
           int x = static_cast<int>(32 * (i % width));
           int y = static_cast<int>(32 * (i / width));
 
-          std::vector<SurfacePtr> regions;
-          std::vector<SurfacePtr> editor_regions;
+          std::vector<TileImageSpec> regions = surfaces;
+          std::vector<TileImageSpec> editor_regions = editor_surfaces;
 
-          for(const auto& surface : surfaces)
+          for(auto& spec : regions)
           {
-            regions.push_back(surface->region(Rect(x, y, Size(32, 32))));
+            spec.region = Rect(x, y, Size(32, 32));
           }
 
-          for(const auto& surface : editor_surfaces)
+          for(auto& spec : editor_regions)
           {
-            editor_regions.push_back(surface->region(Rect(x, y, Size(32, 32))));
+            spec.region = Rect(x, y, Size(32, 32));
           }
 
           auto tile = std::make_unique<Tile>(regions,
@@ -290,14 +283,14 @@ TileSetParser::parse_tiles(const ReaderMapping& reader)
           int x = static_cast<int>(32 * (i % width));
           int y = static_cast<int>(32 * (i / width));
 
-          std::vector<SurfacePtr> surfaces;
+          std::vector<TileImageSpec> surfaces;
           boost::optional<ReaderMapping> surfaces_mapping;
           if(reader.get("image", surfaces_mapping) ||
              reader.get("images", surfaces_mapping)) {
             surfaces = parse_imagespecs(*surfaces_mapping, Rect(x, y, Size(32, 32)));
           }
 
-          std::vector<SurfacePtr> editor_surfaces;
+          std::vector<TileImageSpec> editor_surfaces;
           boost::optional<ReaderMapping> editor_surfaces_mapping;
           if(reader.get("editor-images", editor_surfaces_mapping)) {
             editor_surfaces = parse_imagespecs(*editor_surfaces_mapping, Rect(x, y, Size(32, 32)));
@@ -316,11 +309,11 @@ TileSetParser::parse_tiles(const ReaderMapping& reader)
   }
 }
 
-std::vector<SurfacePtr>
+std::vector<TileImageSpec>
   TileSetParser::parse_imagespecs(const ReaderMapping& images_lisp,
                                   const boost::optional<Rect>& surface_region) const
 {
-  std::vector<SurfacePtr> surfaces;
+  std::vector<TileImageSpec> surfaces;
 
   // (images "foo.png" "foo.bar" ...)
   // (images (region "foo.png" 0 0 32 32))
@@ -329,12 +322,21 @@ std::vector<SurfacePtr>
   {
     if(iter.is_string())
     {
-      std::string file = iter.as_string_item();
-      surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file), surface_region));
+      TileImageSpec spec;
+      spec.file = FileSystem::join(m_tiles_path, iter.as_string_item());
+      spec.rect = surface_region;
+      surfaces.push_back(spec);
     }
     else if(iter.is_pair() && iter.get_key() == "surface")
     {
-      surfaces.push_back(Surface::from_reader(iter.as_mapping(), surface_region));
+      std::ostringstream out;
+      out << iter.as_mapping().get_sexp();
+
+      TileImageSpec spec;
+      spec.file = m_filename;
+      spec.surface = out.str();
+      spec.rect = surface_region;
+      surfaces.push_back(spec);
     }
     else if(iter.is_pair() && iter.get_key() == "region")
     {
@@ -363,8 +365,10 @@ std::vector<SurfacePtr>
           rect.bottom = rect.top + surface_region->get_height();
         }
 
-        surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file),
-                                              rect));
+        TileImageSpec spec;
+        spec.file = FileSystem::join(m_tiles_path, file);
+        spec.rect = rect;
+        surfaces.push_back(spec);
       }
     }
     else
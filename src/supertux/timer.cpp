@@ -18,6 +18,8 @@
 
 #include "supertux/timer.hpp"
 
+#include "supertux/snapshot.hpp"
+
 Timer::Timer() :
   period(0),
 cycle_start(0),
@@ -51,4 +53,22 @@ Timer::check()
   return false;
 }
 
+void
+Timer::backup(SnapshotWriter& writer) const
+{
+  writer.write(period);
+  writer.write(get_timegone());
+  writer.write(cyclic);
+}
+
+void
+Timer::restore(SnapshotReader& reader)
+{
+  float timegone;
+  reader.read(period);
+  reader.read(timegone);
+  reader.read(cyclic);
+  cycle_start = g_game_time - timegone;
+}
+
 /* EOF */
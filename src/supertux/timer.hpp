@@ -19,6 +19,9 @@
 
 #include "supertux/globals.hpp"
 
+class SnapshotReader;
+class SnapshotWriter;
+
 /**
  * Simple timer designed to be used in the update functions of objects
  */
@@ -50,6 +53,11 @@ public:
   bool started() const
   { return period != 0 && get_timeleft() > 0; }
 
+  /** store the timer relative to g_game_time, so that a restored
+   * timer has the same time left as when it was stored */
+  void backup(SnapshotWriter& writer) const;
+  void restore(SnapshotReader& reader);
+
 private:
   float period;
   float cycle_start;
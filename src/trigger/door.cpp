@@ -17,15 +17,20 @@
 #include "trigger/door.hpp"
 
 #include "audio/sound_manager.hpp"
+#include "object/player.hpp"
 #include "sprite/sprite.hpp"
 #include "sprite/sprite_manager.hpp"
 #include "supertux/fadein.hpp"
 #include "supertux/fadeout.hpp"
 #include "supertux/game_session.hpp"
+#include "supertux/level.hpp"
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "util/reader_mapping.hpp"
 
+/** distance at which the target sector starts to get prepared */
+static const float PREWARM_DISTANCE = 640.0f;
+
 Door::Door(const ReaderMapping& reader) :
   state(CLOSED),
   target_sector(),
@@ -81,6 +86,7 @@ Door::update(float )
 {
   switch (state) {
     case CLOSED:
+      prewarm_target_sector();
       break;
     case OPENING:
       // if door has finished opening, start timer and keep door open
@@ -107,6 +113,20 @@ Door::update(float )
   }
 }
 
+void
+Door::prewarm_target_sector()
+{
+  if (target_sector.empty() || !Sector::current())
+    return;
+
+  // get the images of the next sector decoding in the background
+  // before the player walks in
+  auto player = Sector::get().get_nearest_player(bbox);
+  if (player && (player->get_bbox().get_middle() - bbox.get_middle()).norm() < PREWARM_DISTANCE) {
+    Sector::get().get_level().prewarm_sector(target_sector);
+  }
+}
+
 void
 Door::draw(DrawingContext& context)
 {
@@ -48,6 +48,9 @@ private:
     CLOSING
   };
 
+  /** starts loading the target sector when the player is close */
+  void prewarm_target_sector();
+
 private:
   DoorState state; /**< current state of the door */
   std::string target_sector; /**< target sector to teleport to */
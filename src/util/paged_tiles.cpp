@@ -0,0 +1,350 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/paged_tiles.hpp"
+
+#include <algorithm>
+
+#include "math/rect.hpp"
+#include "util/tile_encoding.hpp"
+
+namespace {
+
+const size_t PAGE_TILES = PagedTiles::PAGE_SIZE * PagedTiles::PAGE_SIZE;
+
+int index_size_for(size_t palette_size)
+{
+  if (palette_size <= 0x100)
+    return 1;
+  else if (palette_size <= 0x10000)
+    return 2;
+  else
+    return 4;
+}
+
+} // namespace
+
+PagedTiles::PagedTiles() :
+  m_width(0),
+  m_height(0),
+  m_pages_x(0),
+  m_pages(),
+  m_palette(1, 0),
+  m_palette_lookup({ { 0, 0 } }),
+  m_index_size(1)
+{
+}
+
+void
+PagedTiles::assign(int width, int height, const std::vector<uint32_t>& tiles, bool packed)
+{
+  clear();
+
+  m_width = std::max(0, width);
+  m_height = std::max(0, height);
+  m_pages_x = (m_width + PAGE_MASK) >> PAGE_SHIFT;
+  const int pages_y = (m_height + PAGE_MASK) >> PAGE_SHIFT;
+
+  // collect the palette first, so that the pages are created with
+  // their final index size
+  std::vector<uint32_t> indices(tiles.size());
+  uint32_t last_id = 0;
+  uint32_t last_index = 0;
+  for(size_t i = 0; i < tiles.size(); ++i)
+  {
+    // tilemaps are mostly runs of the same id
+    if (tiles[i] != last_id)
+    {
+      last_id = tiles[i];
+      last_index = get_index(last_id);
+    }
+    indices[i] = last_index;
+  }
+
+  m_pages.resize(m_pages_x * pages_y);
+
+  std::vector<uint32_t> page_indices;
+  for(int py = 0; py < pages_y; ++py)
+  {
+    for(int px = 0; px < m_pages_x; ++px)
+    {
+      const int left = px << PAGE_SHIFT;
+      const int top = py << PAGE_SHIFT;
+      const int right = std::min(left + PAGE_SIZE, m_width);
+      const int bottom = std::min(top + PAGE_SIZE, m_height);
+
+      page_indices.assign(PAGE_TILES, 0);
+      bool empty = true;
+      for(int y = top; y < bottom; ++y)
+      {
+        for(int x = left; x < right; ++x)
+        {
+          const uint32_t index = indices[y * m_width + x];
+          page_indices[((y - top) << PAGE_SHIFT) | (x - left)] = index;
+          empty = empty && index == 0;
+        }
+      }
+      if (empty)
+        continue;
+
+      Page& page = m_pages[py * m_pages_x + px];
+      if (packed)
+        page.packed = TileEncoding::encode_runs(page_indices.data(), page_indices.size());
+      else
+        set_page_indices(page, page_indices, m_index_size);
+    }
+  }
+}
+
+void
+PagedTiles::clear()
+{
+  m_width = 0;
+  m_height = 0;
+  m_pages_x = 0;
+  m_pages.clear();
+  m_palette.assign(1, 0);
+  m_palette_lookup = { { 0, 0 } };
+  m_index_size = 1;
+}
+
+void
+PagedTiles::set(int x, int y, uint32_t id)
+{
+  set_index_at(x, y, get_index(id));
+}
+
+uint32_t
+PagedTiles::get_index_at(int x, int y) const
+{
+  Page& page = m_pages[(y >> PAGE_SHIFT) * m_pages_x + (x >> PAGE_SHIFT)];
+  if (!is_unpacked(page))
+  {
+    if (page.packed.empty())
+      return 0;
+    unpack(page);
+  }
+
+  const size_t i = static_cast<size_t>(((y & PAGE_MASK) << PAGE_SHIFT) | (x & PAGE_MASK));
+  switch (m_index_size)
+  {
+    case 1: return page.indices8[i];
+    case 2: return page.indices16[i];
+    default: return page.indices32[i];
+  }
+}
+
+void
+PagedTiles::set_index_at(int x, int y, uint32_t index)
+{
+  Page& page = m_pages[(y >> PAGE_SHIFT) * m_pages_x + (x >> PAGE_SHIFT)];
+  if (!is_unpacked(page))
+  {
+    if (page.packed.empty() && index == 0)
+      return;
+    unpack(page);
+  }
+
+  const size_t i = static_cast<size_t>(((y & PAGE_MASK) << PAGE_SHIFT) | (x & PAGE_MASK));
+  switch (m_index_size)
+  {
+    case 1: page.indices8[i] = static_cast<uint8_t>(index); break;
+    case 2: page.indices16[i] = static_cast<uint16_t>(index); break;
+    default: page.indices32[i] = index; break;
+  }
+}
+
+std::vector<uint32_t>
+PagedTiles::get_all() const
+{
+  std::vector<uint32_t> tiles(size(), m_palette[0]);
+  for(size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const Page& page = m_pages[i];
+
+    // read packed pages without keeping them unpacked
+    std::vector<uint32_t> indices;
+    if (is_unpacked(page))
+      indices = get_page_indices(page, m_index_size);
+    else if (!page.packed.empty())
+      TileEncoding::decode_runs(page.packed, PAGE_TILES, indices);
+    else
+      continue;
+
+    const int left = static_cast<int>(i % m_pages_x) << PAGE_SHIFT;
+    const int top = static_cast<int>(i / m_pages_x) << PAGE_SHIFT;
+    const int right = std::min(left + PAGE_SIZE, m_width);
+    const int bottom = std::min(top + PAGE_SIZE, m_height);
+    for(int y = top; y < bottom; ++y)
+    {
+      for(int x = left; x < right; ++x)
+      {
+        tiles[y * m_width + x] = m_palette[indices[((y - top) << PAGE_SHIFT) | (x - left)]];
+      }
+    }
+  }
+  return tiles;
+}
+
+void
+PagedTiles::pack_outside(const Rect& keep)
+{
+  for(size_t i = 0; i < m_pages.size(); ++i)
+  {
+    Page& page = m_pages[i];
+    if (!is_unpacked(page))
+      continue;
+
+    const int left = static_cast<int>(i % m_pages_x) << PAGE_SHIFT;
+    const int top = static_cast<int>(i / m_pages_x) << PAGE_SHIFT;
+    if (left + PAGE_SIZE <= keep.left || left >= keep.right ||
+        top + PAGE_SIZE <= keep.top || top >= keep.bottom)
+    {
+      pack(page);
+    }
+  }
+}
+
+int
+PagedTiles::get_unpacked_page_count() const
+{
+  return static_cast<int>(std::count_if(m_pages.begin(), m_pages.end(),
+                                        [this](const Page& page) { return is_unpacked(page); }));
+}
+
+size_t
+PagedTiles::get_memory_usage() const
+{
+  size_t usage = m_pages.capacity() * sizeof(Page);
+  for(const auto& page : m_pages)
+  {
+    usage += page.indices8.capacity() * sizeof(uint8_t);
+    usage += page.indices16.capacity() * sizeof(uint16_t);
+    usage += page.indices32.capacity() * sizeof(uint32_t);
+    usage += page.packed.capacity();
+  }
+  usage += m_palette.capacity() * sizeof(uint32_t);
+  usage += m_palette_lookup.bucket_count() * sizeof(void*) +
+           m_palette_lookup.size() * (sizeof(std::pair<const uint32_t, uint32_t>) + sizeof(void*));
+  return usage;
+}
+
+void
+PagedTiles::unpack(Page& page) const
+{
+  std::vector<uint32_t> indices;
+  if (page.packed.empty())
+  {
+    indices.assign(PAGE_TILES, 0);
+  }
+  else
+  {
+    TileEncoding::decode_runs(page.packed, PAGE_TILES, indices);
+    std::string().swap(page.packed);
+  }
+  set_page_indices(page, indices, m_index_size);
+}
+
+void
+PagedTiles::pack(Page& page) const
+{
+  const std::vector<uint32_t> indices = get_page_indices(page, m_index_size);
+  if (std::any_of(indices.begin(), indices.end(), [](uint32_t index) { return index != 0; }))
+  {
+    page.packed = TileEncoding::encode_runs(indices.data(), indices.size());
+    page.packed.shrink_to_fit();
+  }
+  set_page_indices(page, {}, m_index_size);
+}
+
+void
+PagedTiles::set_page_indices(Page& page, const std::vector<uint32_t>& indices, int index_size)
+{
+  std::vector<uint8_t>().swap(page.indices8);
+  std::vector<uint16_t>().swap(page.indices16);
+  std::vector<uint32_t>().swap(page.indices32);
+
+  switch (index_size)
+  {
+    case 1: page.indices8.assign(indices.begin(), indices.end()); break;
+    case 2: page.indices16.assign(indices.begin(), indices.end()); break;
+    default: page.indices32 = indices; break;
+  }
+}
+
+std::vector<uint32_t>
+PagedTiles::get_page_indices(const Page& page, int index_size)
+{
+  switch (index_size)
+  {
+    case 1: return std::vector<uint32_t>(page.indices8.begin(), page.indices8.end());
+    case 2: return std::vector<uint32_t>(page.indices16.begin(), page.indices16.end());
+    default: return page.indices32;
+  }
+}
+
+uint32_t
+PagedTiles::get_index(uint32_t id)
+{
+  auto it = m_palette_lookup.find(id);
+  if (it != m_palette_lookup.end())
+    return it->second;
+
+  const uint32_t index = static_cast<uint32_t>(m_palette.size());
+  m_palette.push_back(id);
+  m_palette_lookup[id] = index;
+  set_index_size(index_size_for(m_palette.size()));
+  return index;
+}
+
+void
+PagedTiles::set_index_size(int index_size)
+{
+  if (index_size == m_index_size)
+    return;
+
+  // packed pages hold the indices themselves and stay valid
+  for(auto& page : m_pages)
+  {
+    if (is_unpacked(page))
+    {
+      set_page_indices(page, get_page_indices(page, m_index_size), index_size);
+    }
+  }
+  m_index_size = index_size;
+}
+
+void
+PagedTiles::set_palette_entry(uint32_t index, uint32_t id)
+{
+  m_palette[index] = id;
+  rebuild_palette_lookup();
+}
+
+void
+PagedTiles::rebuild_palette_lookup()
+{
+  // after a transform() several indices can have the same id, any of
+  // them will do
+  m_palette_lookup.clear();
+  for(size_t i = 0; i < m_palette.size(); ++i)
+  {
+    m_palette_lookup.emplace(m_palette[i], static_cast<uint32_t>(i));
+  }
+}
+
+/* EOF */
@@ -0,0 +1,175 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_PAGED_TILES_HPP
+#define HEADER_SUPERTUX_UTIL_PAGED_TILES_HPP
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Rect;
+
+/** The tile ids of a tilemap, split into square pages. Pages that
+    contain only 0 take no memory. A page can be packed with the
+    TileEncoding run-length format when it is far away from the
+    camera. The next access unpacks it again, so callers never see
+    whether a page is packed.
+
+    The pages don't hold the ids themselves. They hold indices into a
+    palette of the ids used on the tilemap, stored as uint8_t while
+    there are at most 256 distinct ids and as uint16_t up to 65536.
+    set() widens all pages when a new id no longer fits. */
+class PagedTiles final
+{
+public:
+  static const int PAGE_SHIFT = 5;
+  static const int PAGE_SIZE = 1 << PAGE_SHIFT;
+  static const int PAGE_MASK = PAGE_SIZE - 1;
+
+public:
+  PagedTiles();
+
+  /** Replaces the content, \a tiles is in row-major order and must
+      have width*height entries. With \a packed the pages are stored
+      packed right away and only unpacked once they are used. */
+  void assign(int width, int height, const std::vector<uint32_t>& tiles, bool packed = false);
+
+  void clear();
+
+  int get_width() const { return m_width; }
+  int get_height() const { return m_height; }
+  size_t size() const { return static_cast<size_t>(m_width) * static_cast<size_t>(m_height); }
+
+  /** x and y have to be inside the tilemap */
+  uint32_t get(int x, int y) const
+  {
+    Page& page = m_pages[(y >> PAGE_SHIFT) * m_pages_x + (x >> PAGE_SHIFT)];
+    if (!is_unpacked(page))
+    {
+      if (page.packed.empty())
+        return m_palette[0];
+      unpack(page);
+    }
+
+    const size_t i = static_cast<size_t>(((y & PAGE_MASK) << PAGE_SHIFT) | (x & PAGE_MASK));
+    switch (m_index_size)
+    {
+      case 1: return m_palette[page.indices8[i]];
+      case 2: return m_palette[page.indices16[i]];
+      default: return m_palette[page.indices32[i]];
+    }
+  }
+
+  /** x and y have to be inside the tilemap */
+  void set(int x, int y, uint32_t id);
+
+  /** The palette index of a tile, unlike the id it tells apart
+      entries that transform() mapped to the same id, so restoring it
+      undoes a set() exactly */
+  uint32_t get_index_at(int x, int y) const;
+
+  /** \a index has to come from get_index_at() since the last assign() */
+  void set_index_at(int x, int y, uint32_t index);
+
+  const std::vector<uint32_t>& get_palette() const { return m_palette; }
+
+  /** Changes the id of one palette entry, to undo a transform() */
+  void set_palette_entry(uint32_t index, uint32_t id);
+
+  /** Returns all tiles in row-major order */
+  std::vector<uint32_t> get_all() const;
+
+  /** Replaces every id with func(id), this only rewrites the palette */
+  template<typename F>
+  void transform(F func)
+  {
+    for(auto& id : m_palette)
+      id = func(id);
+    rebuild_palette_lookup();
+  }
+
+  /** Packs the unpacked pages that don't overlap \a keep, given in
+      tile coordinates, pages with only index 0 are released entirely */
+  void pack_outside(const Rect& keep);
+
+  int get_unpacked_page_count() const;
+
+  /** Bytes per tile in an unpacked page: 1, 2 or 4 */
+  int get_index_size() const { return m_index_size; }
+
+  size_t get_palette_size() const { return m_palette.size(); }
+
+  /** Bytes used by the pages and the palette, without the object itself */
+  size_t get_memory_usage() const;
+
+private:
+  struct Page
+  {
+    Page() : indices8(), indices16(), indices32(), packed() {}
+
+    /** PAGE_SIZE*PAGE_SIZE palette indices when the page is
+        unpacked, only the vector matching the index size is used */
+    std::vector<uint8_t> indices8;
+    std::vector<uint16_t> indices16;
+    std::vector<uint32_t> indices32;
+
+    /** TileEncoding runs of the indices when the page is packed */
+    std::string packed;
+  };
+
+  bool is_unpacked(const Page& page) const
+  {
+    switch (m_index_size)
+    {
+      case 1: return !page.indices8.empty();
+      case 2: return !page.indices16.empty();
+      default: return !page.indices32.empty();
+    }
+  }
+
+  /** Unpacks the page, an empty page becomes all index 0 */
+  void unpack(Page& page) const;
+  void pack(Page& page) const;
+
+  static void set_page_indices(Page& page, const std::vector<uint32_t>& indices, int index_size);
+  static std::vector<uint32_t> get_page_indices(const Page& page, int index_size);
+
+  /** Returns the palette index of \a id, adding it if needed */
+  uint32_t get_index(uint32_t id);
+
+  void set_index_size(int index_size);
+  void rebuild_palette_lookup();
+
+private:
+  int m_width;
+  int m_height;
+  int m_pages_x;
+
+  /** mutable as get() unpacks on demand */
+  mutable std::vector<Page> m_pages;
+
+  /** palette index -> tile id, index 0 is what empty pages read as */
+  std::vector<uint32_t> m_palette;
+  std::unordered_map<uint32_t, uint32_t> m_palette_lookup;
+  int m_index_size;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,146 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_PERFECT_HASH_MAP_HPP
+#define HEADER_SUPERTUX_UTIL_PERFECT_HASH_MAP_HPP
+
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/** A read-only map from strings to values. When the map is built, it
+    searches for a hash seed that gives every key its own slot. A
+    lookup then hashes the key once and compares a single string. It
+    is meant for the small, fixed key sets that get looked up over and
+    over, like the actions of a sprite. */
+template<typename T>
+class PerfectHashMap final
+{
+public:
+  PerfectHashMap() :
+    m_seed(0),
+    m_mask(0),
+    m_slots()
+  {}
+
+  /** Replaces the content, for duplicate keys the last value is kept.
+      Throws std::runtime_error when no collision-free table is
+      found, which won't happen for distinct keys in practice. */
+  void build(const std::vector<std::pair<std::string, T> >& entries)
+  {
+    std::vector<std::pair<std::string, T> > unique;
+    std::unordered_map<std::string, size_t> positions;
+    for(const auto& entry : entries)
+    {
+      auto it = positions.find(entry.first);
+      if (it == positions.end())
+      {
+        positions[entry.first] = unique.size();
+        unique.push_back(entry);
+      }
+      else
+      {
+        unique[it->second].second = entry.second;
+      }
+    }
+
+    m_slots.clear();
+    if (unique.empty())
+      return;
+
+    size_t size = 1;
+    while (size < unique.size() * 2)
+      size *= 2;
+
+    for(; size <= (1u << 20); size *= 2)
+    {
+      for(uint32_t seed = 1; seed <= 256; ++seed)
+      {
+        std::vector<Slot> slots(size);
+        bool collision = false;
+        for(const auto& entry : unique)
+        {
+          Slot& slot = slots[hash(entry.first, seed) & (size - 1)];
+          if (slot.used)
+          {
+            collision = true;
+            break;
+          }
+          slot.used = true;
+          slot.key = entry.first;
+          slot.value = entry.second;
+        }
+
+        if (!collision)
+        {
+          m_seed = seed;
+          m_mask = static_cast<uint32_t>(size - 1);
+          m_slots = std::move(slots);
+          return;
+        }
+      }
+    }
+    throw std::runtime_error("PerfectHashMap: no collision-free table found");
+  }
+
+  /** Returns nullptr when \a key isn't in the map */
+  const T* find(const std::string& key) const
+  {
+    if (m_slots.empty())
+      return nullptr;
+
+    const Slot& slot = m_slots[hash(key, m_seed) & m_mask];
+    return (slot.used && slot.key == key) ? &slot.value : nullptr;
+  }
+
+  bool empty() const { return m_slots.empty(); }
+
+private:
+  struct Slot
+  {
+    Slot() : used(false), key(), value() {}
+
+    bool used;
+    std::string key;
+    T value;
+  };
+
+  /** FNV-1a with the seed mixed into the offset basis */
+  static uint32_t hash(const std::string& key, uint32_t seed)
+  {
+    uint32_t h = 2166136261u ^ (seed * 16777619u);
+    for(char c : key)
+    {
+      h ^= static_cast<uint8_t>(c);
+      h *= 16777619u;
+    }
+    // fold the high bits in, the mask only looks at the low ones
+    return h ^ (h >> 15);
+  }
+
+private:
+  uint32_t m_seed;
+  uint32_t m_mask;
+  std::vector<Slot> m_slots;
+};
+
+#endif
+
+/* EOF */
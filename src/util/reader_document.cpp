@@ -16,18 +16,634 @@
 
 #include "util/reader_document.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <ctype.h>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <physfs.h>
 #include <sexp/parser.hpp>
 #include <sstream>
+#include <string.h>
 
 #include "physfs/ifile_streambuf.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
+#include "util/obstackpp.hpp"
+
+namespace {
+
+const char* const PACKED_ARRAY_SYMBOL = "packed-array";
+
+/** Shorter lists aren't worth packing */
+const size_t PACKED_ARRAY_MIN_SIZE = 16;
+
+/** Keys whose values are long lists of integers: tilemap tiles,
+    tilegroups and the tile ids of tilesets */
+const char* const PACKED_KEYS[] = { "tiles", "ids", "attributes", "datas" };
+
+bool is_space(char c)
+{
+  return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+bool is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+bool is_symbol_char(char c)
+{
+  return !is_space(c) && c != '(' && c != ')' && c != '"' && c != ';';
+}
+
+bool is_packed_key(const std::string& text, size_t pos, size_t length)
+{
+  for(const char* key : PACKED_KEYS)
+  {
+    if (strlen(key) == length && text.compare(pos, length, key) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** Returns the position after the string literal starting at \a pos */
+size_t skip_string(const std::string& text, size_t pos)
+{
+  for(size_t i = pos + 1; i < text.size(); ++i)
+  {
+    if (text[i] == '\\')
+      ++i;
+    else if (text[i] == '"')
+      return i + 1;
+  }
+  return text.size();
+}
+
+/** Reads the integers up to the closing parenthesis of the list into
+    the growing object of \a obst, \a pos is moved onto the
+    parenthesis. Returns false when the list contains anything else. */
+bool read_integer_list(const std::string& text, size_t& pos, obstack& obst, size_t& newlines)
+{
+  while(true)
+  {
+    if (pos >= text.size())
+      return false;
+
+    const char c = text[pos];
+    if (c == ')')
+    {
+      return true;
+    }
+    else if (is_space(c))
+    {
+      if (c == '\n')
+        newlines += 1;
+      ++pos;
+    }
+    else if (is_digit(c))
+    {
+      uint64_t value = 0;
+      for(; pos < text.size() && is_digit(text[pos]); ++pos)
+      {
+        value = value * 10 + static_cast<uint64_t>(text[pos] - '0');
+        if (value > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+          return false;
+      }
+
+      if (pos < text.size() && !is_space(text[pos]) && text[pos] != ')')
+        return false;
+
+      const uint32_t item = static_cast<uint32_t>(value);
+      obstack_grow(&obst, &item, sizeof(item));
+    }
+    else
+    {
+      return false;
+    }
+  }
+}
+
+/** Tries to decode the list starting at \a pos, which has to be a
+    known key followed by non-negative integers only. On success the
+    list is replaced by (key packed-array INDEX) in \a out, keeping
+    the line count intact for error messages, and \a pos is moved
+    past it. */
+bool pack_list(const std::string& text, size_t& pos, std::string& out,
+               obstack& obst, std::vector<ReaderDocument::PackedArray>& arrays)
+{
+  const size_t key_begin = pos + 1;
+  size_t key_end = key_begin;
+  while(key_end < text.size() && is_symbol_char(text[key_end]))
+    ++key_end;
+
+  if (!is_packed_key(text, key_begin, key_end - key_begin))
+    return false;
+
+  size_t i = key_end;
+  size_t newlines = 0;
+  const bool success = read_integer_list(text, i, obst, newlines);
+  const size_t count = static_cast<size_t>(obstack_object_size(&obst)) / sizeof(uint32_t);
+  void* data = obstack_finish(&obst);
+  if (!success || count < PACKED_ARRAY_MIN_SIZE)
+  {
+    obstack_free(&obst, data);
+    return false;
+  }
+
+  out.append(text, pos, key_end - pos);
+  out += ' ';
+  out += PACKED_ARRAY_SYMBOL;
+  out += ' ';
+  out += std::to_string(arrays.size());
+  out.append(newlines, '\n');
+  out += ')';
+
+  arrays.push_back({static_cast<const uint32_t*>(data), count});
+  pos = i + 1;
+  return true;
+}
+
+/** Copies \a text, with the long integer lists under the known keys
+    decoded into \a arrays instead of being left for the sexp parser,
+    which would create a node for every single integer */
+std::string pack_integer_lists(const std::string& text, obstack& obst,
+                               std::vector<ReaderDocument::PackedArray>& arrays)
+{
+  std::string out;
+  size_t pos = 0;
+  while(pos < text.size())
+  {
+    const char c = text[pos];
+    if (c == '"')
+    {
+      const size_t end = skip_string(text, pos);
+      out.append(text, pos, end - pos);
+      pos = end;
+    }
+    else if (c == ';')
+    {
+      const size_t end = std::min(text.find('\n', pos), text.size());
+      out.append(text, pos, end - pos);
+      pos = end;
+    }
+    else if (c == '(' && pack_list(text, pos, out, obst, arrays))
+    {
+    }
+    else
+    {
+      const size_t end = std::min(text.find_first_of("\"(;", pos + 1), text.size());
+      out.append(text, pos, end - pos);
+      pos = end;
+    }
+  }
+  return out;
+}
+
+void delete_obstack(obstack* obst)
+{
+  obstack_free(obst, nullptr);
+  delete obst;
+}
+
+/* The compiled format, all numbers are little-endian:
+
+     "STLB" VERSION:u32 SOURCE_MODTIME:i64 SOURCE_SIZE:i64
+     STRING_COUNT:u32 (LENGTH:u32 BYTES)* PADDING
+     NODE
+
+   The padding aligns the root node to four bytes, blobs are aligned
+   relative to it, so that they can be used in place. A node is a tag
+   byte followed by its payload. */
+const char COMPILED_MAGIC[4] = { 'S', 'T', 'L', 'B' };
+const uint32_t COMPILED_VERSION = 2;
+
+enum CompiledTag : uint8_t
+{
+  TAG_NIL,
+  TAG_BOOLEAN,   // value:u8
+  TAG_INTEGER,   // value:i32
+  TAG_REAL,      // value:f32
+  TAG_STRING,    // string:u32
+  TAG_SYMBOL,    // string:u32
+  TAG_ARRAY,     // count:u32 NODE*
+  TAG_PACKED     // key:u32 count:u32 PADDING value:u32*
+};
+
+bool is_little_endian()
+{
+  const uint16_t probe = 1;
+  return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+}
+
+uint32_t swap_bytes(uint32_t value)
+{
+  return ((value & 0xff) << 24) | ((value & 0xff00) << 8) |
+         ((value >> 8) & 0xff00) | (value >> 24);
+}
+
+class CompiledWriter final
+{
+public:
+  CompiledWriter(const ReaderDocument& doc) :
+    m_doc(doc),
+    m_strings(),
+    m_string_table(),
+    m_body()
+  {}
+
+  void write_node(const sexp::Value& sx)
+  {
+    const ReaderDocument::PackedArray* packed = m_doc.get_packed_array(sx);
+    if (packed)
+    {
+      write_u8(TAG_PACKED);
+      write_u32(get_string(sx.as_array()[0].as_string()));
+      write_u32(static_cast<uint32_t>(packed->size));
+      pad();
+      for(size_t i = 0; i < packed->size; ++i)
+      {
+        write_u32(packed->data[i]);
+      }
+    }
+    else if (sx.is_nil())
+    {
+      write_u8(TAG_NIL);
+    }
+    else if (sx.is_boolean())
+    {
+      write_u8(TAG_BOOLEAN);
+      write_u8(sx.as_bool() ? 1 : 0);
+    }
+    else if (sx.is_integer())
+    {
+      write_u8(TAG_INTEGER);
+      write_u32(static_cast<uint32_t>(sx.as_int()));
+    }
+    else if (sx.is_real())
+    {
+      const float value = sx.as_float();
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      write_u8(TAG_REAL);
+      write_u32(bits);
+    }
+    else if (sx.is_string())
+    {
+      write_u8(TAG_STRING);
+      write_u32(get_string(sx.as_string()));
+    }
+    else if (sx.is_symbol())
+    {
+      write_u8(TAG_SYMBOL);
+      write_u32(get_string(sx.as_string()));
+    }
+    else if (sx.is_array())
+    {
+      auto const& arr = sx.as_array();
+      write_u8(TAG_ARRAY);
+      write_u32(static_cast<uint32_t>(arr.size()));
+      for(auto const& item : arr)
+      {
+        write_node(item);
+      }
+    }
+    else
+    {
+      throw std::runtime_error("can't compile document, unsupported expression: " + sx.str());
+    }
+  }
+
+  void write(std::ostream& out, const ReaderDocument::CompiledSource& source)
+  {
+    std::string header(COMPILED_MAGIC, sizeof(COMPILED_MAGIC));
+    append_u32(header, COMPILED_VERSION);
+    append_i64(header, source.modtime);
+    append_i64(header, source.size);
+    append_u32(header, static_cast<uint32_t>(m_string_table.size()));
+    for(const std::string* str : m_string_table)
+    {
+      append_u32(header, static_cast<uint32_t>(str->size()));
+      header += *str;
+    }
+    header.append((4 - header.size() % 4) % 4, '\0');
+
+    out.write(header.data(), header.size());
+    out.write(m_body.data(), m_body.size());
+  }
+
+private:
+  static void append_u32(std::string& out, uint32_t value)
+  {
+    for(int i = 0; i < 4; ++i)
+    {
+      out += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+  }
+
+  static void append_i64(std::string& out, int64_t value)
+  {
+    append_u32(out, static_cast<uint32_t>(static_cast<uint64_t>(value) & 0xffffffffu));
+    append_u32(out, static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32));
+  }
+
+  void write_u8(uint8_t value) { m_body += static_cast<char>(value); }
+  void write_u32(uint32_t value) { append_u32(m_body, value); }
+  void pad() { m_body.append((4 - m_body.size() % 4) % 4, '\0'); }
+
+  uint32_t get_string(const std::string& str)
+  {
+    auto it = m_strings.find(str);
+    if (it == m_strings.end())
+    {
+      it = m_strings.insert(std::make_pair(str, static_cast<uint32_t>(m_string_table.size()))).first;
+      m_string_table.push_back(&it->first);
+    }
+    return it->second;
+  }
+
+private:
+  const ReaderDocument& m_doc;
+  std::map<std::string, uint32_t> m_strings;
+  std::vector<const std::string*> m_string_table;
+  std::string m_body;
+
+private:
+  CompiledWriter(const CompiledWriter&) = delete;
+  CompiledWriter& operator=(const CompiledWriter&) = delete;
+};
+
+class CompiledReader final
+{
+public:
+  CompiledReader(uint8_t* data, size_t size, std::vector<ReaderDocument::PackedArray>& packed_arrays) :
+    m_data(data),
+    m_size(size),
+    m_pos(0),
+    m_body(0),
+    m_strings(),
+    m_packed_arrays(packed_arrays)
+  {}
+
+  sexp::Value read(const ReaderDocument::CompiledSource* source)
+  {
+    if (m_size < sizeof(COMPILED_MAGIC) || memcmp(m_data, COMPILED_MAGIC, sizeof(COMPILED_MAGIC)) != 0)
+      throw std::runtime_error("not a compiled document");
+    m_pos += sizeof(COMPILED_MAGIC);
+
+    if (read_u32() != COMPILED_VERSION)
+      throw std::runtime_error("unsupported compiled document version");
+
+    const int64_t source_modtime = read_i64();
+    const int64_t source_size = read_i64();
+    if (source && (source->modtime != source_modtime || source->size != source_size))
+      throw std::runtime_error("compiled document is out of date");
+
+    const uint32_t string_count = read_u32();
+    m_strings.reserve(std::min<size_t>(string_count, m_size));
+    for(uint32_t i = 0; i < string_count; ++i)
+    {
+      const uint32_t length = read_u32();
+      require(length);
+      m_strings.emplace_back(reinterpret_cast<const char*>(m_data + m_pos), length);
+      m_pos += length;
+    }
+    skip_padding();
+    m_body = m_pos;
+
+    sexp::Value root = read_node();
+    if (m_pos != m_size)
+      throw std::runtime_error("trailing data in compiled document");
+    return root;
+  }
+
+private:
+  sexp::Value read_node()
+  {
+    switch(read_u8())
+    {
+      case TAG_NIL:
+        return sexp::Value::nil();
+
+      case TAG_BOOLEAN:
+        return sexp::Value::boolean(read_u8() != 0);
+
+      case TAG_INTEGER:
+        return sexp::Value::integer(static_cast<int>(read_u32()));
+
+      case TAG_REAL:
+      {
+        const uint32_t bits = read_u32();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return sexp::Value::real(value);
+      }
+
+      case TAG_STRING:
+        return sexp::Value::string(read_string());
+
+      case TAG_SYMBOL:
+        return sexp::Value::symbol(read_string());
+
+      case TAG_ARRAY:
+      {
+        const uint32_t count = read_u32();
+        require(count);
+        std::vector<sexp::Value> items;
+        items.reserve(count);
+        for(uint32_t i = 0; i < count; ++i)
+        {
+          items.push_back(read_node());
+        }
+        return sexp::Value::array(std::move(items));
+      }
+
+      case TAG_PACKED:
+      {
+        const std::string& key = read_string();
+        const uint32_t count = read_u32();
+        skip_padding();
+        require(static_cast<size_t>(count) * sizeof(uint32_t));
+
+        auto values = reinterpret_cast<uint32_t*>(m_data + m_pos);
+        m_pos += static_cast<size_t>(count) * sizeof(uint32_t);
+        if (!is_little_endian())
+        {
+          std::transform(values, values + count, values, swap_bytes);
+        }
+
+        std::vector<sexp::Value> items;
+        items.push_back(sexp::Value::symbol(key));
+        items.push_back(sexp::Value::symbol(PACKED_ARRAY_SYMBOL));
+        items.push_back(sexp::Value::integer(static_cast<int>(m_packed_arrays.size())));
+        m_packed_arrays.push_back({values, count});
+        return sexp::Value::array(std::move(items));
+      }
+
+      default:
+        throw std::runtime_error("corrupt compiled document");
+    }
+  }
+
+  void require(size_t bytes) const
+  {
+    if (m_size - m_pos < bytes)
+      throw std::runtime_error("truncated compiled document");
+  }
+
+  void skip_padding()
+  {
+    const size_t padding = (4 - (m_pos - m_body) % 4) % 4;
+    require(padding);
+    m_pos += padding;
+  }
+
+  uint8_t read_u8()
+  {
+    require(1);
+    return m_data[m_pos++];
+  }
+
+  uint32_t read_u32()
+  {
+    require(4);
+    const uint32_t value = static_cast<uint32_t>(m_data[m_pos]) |
+                           (static_cast<uint32_t>(m_data[m_pos + 1]) << 8) |
+                           (static_cast<uint32_t>(m_data[m_pos + 2]) << 16) |
+                           (static_cast<uint32_t>(m_data[m_pos + 3]) << 24);
+    m_pos += 4;
+    return value;
+  }
+  int64_t read_i64()
+  {
+    const uint64_t low = read_u32();
+    const uint64_t high = read_u32();
+    return static_cast<int64_t>(low | (high << 32));
+  }
+
+
+  const std::string& read_string()
+  {
+    const uint32_t index = read_u32();
+    if (index >= m_strings.size())
+      throw std::runtime_error("corrupt compiled document");
+    return m_strings[index];
+  }
+
+private:
+  uint8_t* m_data;
+  size_t m_size;
+  size_t m_pos;
+
+  /** start of the root node, padding is relative to it */
+  size_t m_body;
+
+  std::vector<std::string> m_strings;
+  std::vector<ReaderDocument::PackedArray>& m_packed_arrays;
+
+private:
+  CompiledReader(const CompiledReader&) = delete;
+  CompiledReader& operator=(const CompiledReader&) = delete;
+};
+
+} // namespace
 
 ReaderDocument
 ReaderDocument::from_stream(std::istream& stream, const std::string& filename)
 {
-  sexp::Value sx = sexp::Parser::from_stream(stream, sexp::Parser::USE_ARRAYS);
-  return ReaderDocument(filename, std::move(sx));
+  const auto start = std::chrono::steady_clock::now();
+
+  const std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+  ReaderDocument doc(filename, sexp::Value());
+  doc.m_sx = sexp::Parser::from_string(pack_integer_lists(text, *doc.m_obst, doc.m_packed_arrays),
+                                       sexp::Parser::USE_ARRAYS);
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  log_debug << "parsed " << filename << " in " << elapsed.count() / 1000.0f << " ms, "
+            << doc.m_packed_arrays.size() << " packed lists, "
+            << obstack_memory_used(doc.m_obst.get()) / 1024 << " KiB arena" << std::endl;
+
+  return doc;
+}
+
+ReaderDocument
+ReaderDocument::from_compiled_stream(std::istream& stream, const std::string& filename)
+{
+  const std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+  ReaderDocument doc(filename, sexp::Value());
+  auto buffer = static_cast<uint8_t*>(obstack_copy(doc.m_obst.get(), data.data(), static_cast<int>(data.size())));
+  doc.load_compiled(buffer, data.size(), nullptr);
+  return doc;
+}
+
+ReaderDocument
+ReaderDocument::from_compiled_file(const std::string& compiled_filename, const std::string& filename)
+{
+  log_debug << "ReaderDocument::load_compiled: " << compiled_filename << std::endl;
+
+  PHYSFS_Stat statbuf;
+  if (!PHYSFS_stat(filename.c_str(), &statbuf))
+  {
+    throw std::runtime_error("Couldn't stat '" + filename + "' that '" + compiled_filename + "' was compiled from");
+  }
+  const CompiledSource source = { statbuf.modtime, statbuf.filesize };
+
+  std::unique_ptr<PHYSFS_File, int(*)(PHYSFS_File*)> file(PHYSFS_openRead(compiled_filename.c_str()), PHYSFS_close);
+  if (!file)
+  {
+    std::ostringstream msg;
+    msg << "Couldn't open compiled file '" << compiled_filename << "': " << PHYSFS_getLastErrorCode();
+    throw std::runtime_error(msg.str());
+  }
+
+  const PHYSFS_sint64 size = PHYSFS_fileLength(file.get());
+  if (size < 0 || size > std::numeric_limits<int>::max())
+  {
+    throw std::runtime_error("Couldn't get the size of compiled file '" + compiled_filename + "'");
+  }
+
+  // the whole file is read in one go into the arena of the document,
+  // the packed lists are used in place
+  ReaderDocument doc(filename, sexp::Value());
+  auto buffer = static_cast<uint8_t*>(obstack_alloc(doc.m_obst.get(), static_cast<int>(size)));
+  if (PHYSFS_readBytes(file.get(), buffer, static_cast<PHYSFS_uint64>(size)) != size)
+  {
+    throw std::runtime_error("Couldn't read compiled file '" + compiled_filename + "'");
+  }
+
+  doc.load_compiled(buffer, static_cast<size_t>(size), &source);
+  return doc;
+}
+
+std::string
+ReaderDocument::get_compiled_filename(const std::string& filename)
+{
+  return filename + "b";
+}
+
+void
+ReaderDocument::load_compiled(uint8_t* data, size_t size, const CompiledSource* source)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  m_sx = CompiledReader(data, size, m_packed_arrays).read(source);
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  log_debug << "loaded compiled " << m_filename << " in " << elapsed.count() / 1000.0f << " ms, "
+            << m_packed_arrays.size() << " packed lists" << std::endl;
+}
+
+void
+ReaderDocument::write_compiled(std::ostream& out, const CompiledSource& source) const
+{
+  CompiledWriter writer(*this);
+  writer.write_node(m_sx);
+  writer.write(out, source);
 }
 
 ReaderDocument
@@ -49,8 +665,12 @@ ReaderDocument::from_file(const std::string& filename)
 
 ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx) :
   m_filename(filename),
-  m_sx(std::move(sx))
+  m_sx(std::move(sx)),
+  m_packed_arrays(),
+  m_obst(new obstack, &delete_obstack),
+  m_mapping_indices()
 {
+  obstack_init(m_obst.get());
 }
 
 ReaderObject
@@ -71,4 +691,23 @@ ReaderDocument::get_directory() const
   return FileSystem::dirname(m_filename);
 }
 
+const ReaderDocument::PackedArray*
+ReaderDocument::get_packed_array(const sexp::Value& sx) const
+{
+  if (m_packed_arrays.empty() || !sx.is_array())
+    return nullptr;
+
+  auto const& arr = sx.as_array();
+  if (arr.size() != 3 ||
+      !arr[1].is_symbol() || arr[1].as_string() != PACKED_ARRAY_SYMBOL ||
+      !arr[2].is_integer())
+    return nullptr;
+
+  const int index = arr[2].as_int();
+  if (index < 0 || static_cast<size_t>(index) >= m_packed_arrays.size())
+    return nullptr;
+
+  return &m_packed_arrays[static_cast<size_t>(index)];
+}
+
 /* EOF */
@@ -18,10 +18,17 @@
 #define HEADER_SUPERTUX_UTIL_READER_DOCUMENT_HPP
 
 #include <istream>
+#include <memory>
 #include <sexp/value.hpp>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 #include "util/reader_object.hpp"
 
+struct ReaderMappingIndex;
+struct obstack;
+
 /** The ReaderDocument holds a parsed document in memory, access to
     it's content is provided by get_root() */
 class ReaderDocument final
@@ -30,6 +37,32 @@ public:
   static ReaderDocument from_stream(std::istream& stream, const std::string& filename = "<stream>");
   static ReaderDocument from_file(const std::string& filename);
 
+  /** Modification time and size of the text file a document was
+      compiled from */
+  struct CompiledSource
+  {
+    int64_t modtime;
+    int64_t size;
+  };
+
+  /** Loads a document that was written with write_compiled(),
+      \a filename is the name of the text file it was compiled from.
+      from_compiled_file() throws when that file doesn't match the
+      CompiledSource stored in the compiled one anymore, the stream
+      version doesn't check it. */
+  static ReaderDocument from_compiled_stream(std::istream& stream, const std::string& filename = "<stream>");
+  static ReaderDocument from_compiled_file(const std::string& compiled_filename, const std::string& filename);
+
+  /** Returns the name of the compiled version of a text file, for
+      levels that is the .stlb next to the .stl */
+  static std::string get_compiled_filename(const std::string& filename);
+
+  struct PackedArray
+  {
+    const uint32_t* data;
+    size_t size;
+  };
+
 public:
   ReaderDocument(const std::string& filename, sexp::Value sx);
 
@@ -42,9 +75,48 @@ public:
   /** Returns the directory of the document */
   std::string get_directory() const;
 
+  /** Returns the values of a long integer list like a tilemap's
+      (tiles ...) that was decoded straight into an array while
+      parsing, \a sx is the (key ...) pair. Returns nullptr when the
+      list wasn't packed. */
+  const PackedArray* get_packed_array(const sexp::Value& sx) const;
+
+  /** Writes the document in the compiled binary format, which is
+      loaded without tokenizing any text: a string table with all
+      symbols and strings, the tree as tagged records referencing it
+      and the packed lists as raw little-endian uint32 blobs. Line
+      numbers are not kept. \a source is stored to detect compiled
+      files that are out of date, modification times only have a
+      resolution of a second, so the size is compared as well. */
+  void write_compiled(std::ostream& out, const CompiledSource& source) const;
+
+  /** Memory that lives as long as the document and is freed in one
+      go with it, not thread-safe */
+  obstack& get_obstack() const { return *m_obst; }
+
+  /** Returns the slot for the key index of the mapping \a sx, so
+      that it is only built once even when the document is read
+      repeatedly, not thread-safe */
+  const ReaderMappingIndex*& get_mapping_index(const sexp::Value& sx) const { return m_mapping_indices[&sx]; }
+
+private:
+  /** \a data has to be allocated in the document's obstack, the
+      packed lists point into it, \a source is nullptr to skip the
+      out of date check */
+  void load_compiled(uint8_t* data, size_t size, const CompiledSource* source);
+
 private:
   std::string m_filename;
   sexp::Value m_sx;
+
+  /** lists that are (key packed-array INDEX) in m_sx, their values
+      live in m_obst */
+  std::vector<PackedArray> m_packed_arrays;
+
+  /** shared, as copies of the document point into it */
+  std::shared_ptr<obstack> m_obst;
+
+  mutable std::unordered_map<const sexp::Value*, const ReaderMappingIndex*> m_mapping_indices;
 };
 
 #endif
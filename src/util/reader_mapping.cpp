@@ -16,23 +16,66 @@
 
 #include "util/reader_mapping.hpp"
 
+#include <algorithm>
 #include <boost/ref.hpp>
 #include <boost/utility/typed_in_place_factory.hpp>
 #include <sexp/io.hpp>
 #include <sstream>
 #include <stdexcept>
+#include <string.h>
 
 #include "util/gettext.hpp"
+#include "util/obstackpp.hpp"
 #include "util/reader_collection.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_error.hpp"
 
+namespace {
+
+/** Mappings with fewer entries than this are searched linearly, for
+    them building the index costs more than it saves */
+const size_t INDEX_THRESHOLD = 8;
+
+/** FNV-1a, so that keys can be hashed without turning them into a
+    std::string first */
+size_t hash_key(const char* key, size_t length)
+{
+  size_t hash = 2166136261u;
+  for(size_t i = 0; i < length; ++i)
+  {
+    hash = (hash ^ static_cast<unsigned char>(key[i])) * 16777619u;
+  }
+  return hash;
+}
+
+} // namespace
+
+struct ReaderMappingIndex
+{
+  struct Entry
+  {
+    size_t hash;
+    size_t pos;
+  };
+
+  /** sorted by hash, entries with the same hash stay in the order
+      they have in the document, so that the first one wins */
+  const Entry* entries;
+  size_t count;
+
+  /** position in the array up to which the entries are indexed, the
+      rest starts with a malformed entry and is left to find_item() so
+      that it reports the error */
+  size_t end;
+};
+
 bool ReaderMapping::s_translations_enabled = true;
 
 ReaderMapping::ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx) :
   m_doc(doc),
   m_sx(sx),
-  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}())
+  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}()),
+  m_index(nullptr)
 {
 }
 
@@ -44,10 +87,73 @@ ReaderMapping::get_iter() const
   return ReaderIterator(m_doc, m_sx);
 }
 
+const ReaderMappingIndex*
+ReaderMapping::create_index() const
+{
+  obstack& obst = m_doc.get_obstack();
+
+  size_t i = 1;
+  for(; i < m_arr.size(); ++i)
+  {
+    auto const& pair = m_arr[i];
+    if (!pair.is_array() || pair.as_array().empty() || !pair.as_array()[0].is_symbol())
+      break;
+
+    const std::string& name = pair.as_array()[0].as_string();
+    const ReaderMappingIndex::Entry entry = {hash_key(name.data(), name.size()), i};
+    obstack_grow(&obst, &entry, sizeof(entry));
+  }
+
+  const size_t count = static_cast<size_t>(obstack_object_size(&obst)) / sizeof(ReaderMappingIndex::Entry);
+  auto entries = static_cast<ReaderMappingIndex::Entry*>(obstack_finish(&obst));
+  std::sort(entries, entries + count,
+            [](const ReaderMappingIndex::Entry& lhs, const ReaderMappingIndex::Entry& rhs) {
+              return lhs.hash < rhs.hash || (lhs.hash == rhs.hash && lhs.pos < rhs.pos);
+            });
+
+  return new(obst) ReaderMappingIndex{entries, count, i};
+}
+
 const sexp::Value*
 ReaderMapping::get_item(const char* key) const
 {
-  for(size_t i = 1; i < m_arr.size(); ++i)
+  if (!m_index)
+  {
+    if (m_arr.size() <= INDEX_THRESHOLD)
+    {
+      return find_item(key, 1);
+    }
+
+    const ReaderMappingIndex*& index = m_doc.get_mapping_index(m_sx);
+    if (!index)
+    {
+      index = create_index();
+    }
+    m_index = index;
+  }
+
+  const size_t hash = hash_key(key, strlen(key));
+  const ReaderMappingIndex::Entry* const end = m_index->entries + m_index->count;
+  auto it = std::lower_bound(m_index->entries, end, hash,
+                             [](const ReaderMappingIndex::Entry& entry, size_t value) {
+                               return entry.hash < value;
+                             });
+  for(; it != end && it->hash == hash; ++it)
+  {
+    auto const& pair = m_arr[it->pos];
+    if (pair.as_array()[0].as_string() == key)
+    {
+      return &pair;
+    }
+  }
+
+  return find_item(key, m_index->end);
+}
+
+const sexp::Value*
+ReaderMapping::find_item(const char* key, size_t start) const
+{
+  for(size_t i = start; i < m_arr.size(); ++i)
   {
     auto const& pair = m_arr[i];
 
@@ -143,10 +249,43 @@ ReaderMapping::get(const char* key, std::string& value, const boost::optional<co
   }
 }
 
+namespace {
+
+template<typename T>
+bool get_packed_values(const ReaderDocument&, const sexp::Value&, std::vector<T>&)
+{
+  return false;
+}
+
+template<typename T>
+bool get_integer_packed_values(const ReaderDocument& doc, const sexp::Value& sx, std::vector<T>& value)
+{
+  auto const packed = doc.get_packed_array(sx);
+  if (!packed)
+    return false;
+
+  value.assign(packed->data, packed->data + packed->size);
+  return true;
+}
+
+bool get_packed_values(const ReaderDocument& doc, const sexp::Value& sx, std::vector<int>& value)
+{
+  return get_integer_packed_values(doc, sx, value);
+}
+
+bool get_packed_values(const ReaderDocument& doc, const sexp::Value& sx, std::vector<unsigned int>& value)
+{
+  return get_integer_packed_values(doc, sx, value);
+}
+
+} // namespace
+
 #define GET_VALUES_MACRO(type, checker, getter)                         \
   auto const sx = get_item(key);                                        \
   if (!sx) {                                                            \
     return false;                                                       \
+  } else if (get_packed_values(m_doc, *sx, value)) {                    \
+    return true;                                                        \
   } else {                                                              \
     assert_is_array(m_doc, *sx);                                        \
     auto const& item = sx->as_array();                                  \
@@ -27,6 +27,7 @@ class Value;
 
 class ReaderDocument;
 class ReaderCollection;
+struct ReaderMappingIndex;
 
 class ReaderMapping final
 {
@@ -79,10 +80,20 @@ private:
   /** Returns pointer to (key value) */
   const sexp::Value* get_item(const char* key) const;
 
+  /** Linear search for \a key, starting at \a start in m_arr */
+  const sexp::Value* find_item(const char* key, size_t start) const;
+
+  const ReaderMappingIndex* create_index() const;
+
 private:
   const ReaderDocument& m_doc;
   const sexp::Value& m_sx;
   const std::vector<sexp::Value>& m_arr;
+
+  /** Hashes of the keys, built on the first lookup in a larger
+      mapping, it lives in the document's obstack and is shared by
+      all mappings of the same expression */
+  mutable const ReaderMappingIndex* m_index;
 };
 
 #endif
@@ -0,0 +1,77 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/thread_pool.hpp"
+
+ThreadPool::ThreadPool(int num_threads) :
+  m_threads(),
+  m_mutex(),
+  m_cond(),
+  m_jobs(),
+  m_quit(false)
+{
+  for(int i = 0; i < num_threads; ++i)
+  {
+    m_threads.emplace_back(&ThreadPool::run, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+    m_jobs.clear();
+  }
+  m_cond.notify_all();
+
+  for(auto& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+void
+ThreadPool::push(std::function<void ()> job)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(std::move(job));
+  }
+  m_cond.notify_one();
+}
+
+void
+ThreadPool::run()
+{
+  while(true)
+  {
+    std::function<void ()> job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cond.wait(lock, [this]{ return m_quit || !m_jobs.empty(); });
+      if (m_quit)
+        return;
+
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+    job();
+  }
+}
+
+/* EOF */
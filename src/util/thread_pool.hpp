@@ -0,0 +1,75 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_THREAD_POOL_HPP
+#define HEADER_SUPERTUX_UTIL_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/** A fixed set of worker threads that run jobs in the order they got
+    scheduled */
+class ThreadPool final
+{
+public:
+  ThreadPool(int num_threads);
+
+  /** Jobs that haven't started yet are dropped, running ones are
+      waited for */
+  ~ThreadPool();
+
+  /** Runs \a func on a worker thread, the future receives its return
+      value or the exception it threw */
+  template<typename Func>
+  std::future<typename std::result_of<Func()>::type> schedule(Func func)
+  {
+    using Result = typename std::result_of<Func()>::type;
+
+    auto task = std::make_shared<std::packaged_task<Result()> >(std::move(func));
+    std::future<Result> future = task->get_future();
+    push([task]{ (*task)(); });
+    return future;
+  }
+
+  int get_thread_count() const { return static_cast<int>(m_threads.size()); }
+
+private:
+  void push(std::function<void ()> job);
+  void run();
+
+private:
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::deque<std::function<void ()> > m_jobs;
+  bool m_quit;
+
+private:
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,187 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/tile_encoding.hpp"
+
+#include <stdexcept>
+
+namespace {
+
+const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void write_varint(std::string& out, uint32_t value)
+{
+  while (value >= 0x80)
+  {
+    out += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+uint32_t read_varint(const std::string& data, size_t& pos)
+{
+  uint32_t value = 0;
+  for (int shift = 0; shift < 35; shift += 7)
+  {
+    if (pos >= data.size())
+      throw std::runtime_error("truncated tile data");
+
+    const uint8_t byte = static_cast<uint8_t>(data[pos++]);
+    if (shift == 28 && (byte & 0x70) != 0)
+      throw std::runtime_error("tile id out of range in tile data");
+
+    value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+  throw std::runtime_error("malformed varint in tile data");
+}
+
+std::string base64_encode(const std::string& data)
+{
+  std::string out;
+  out.reserve((data.size() + 2) / 3 * 4);
+  for (size_t i = 0; i < data.size(); i += 3)
+  {
+    const size_t left = data.size() - i;
+    uint32_t chunk = static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << 16;
+    if (left > 1) chunk |= static_cast<uint32_t>(static_cast<uint8_t>(data[i + 1])) << 8;
+    if (left > 2) chunk |= static_cast<uint32_t>(static_cast<uint8_t>(data[i + 2]));
+
+    out += BASE64_ALPHABET[(chunk >> 18) & 0x3f];
+    out += BASE64_ALPHABET[(chunk >> 12) & 0x3f];
+    out += left > 1 ? BASE64_ALPHABET[(chunk >> 6) & 0x3f] : '=';
+    out += left > 2 ? BASE64_ALPHABET[chunk & 0x3f] : '=';
+  }
+  return out;
+}
+
+int base64_value(char c)
+{
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+') return 62;
+  if (c == '/') return 63;
+  return -1;
+}
+
+std::string base64_decode(const std::string& text)
+{
+  std::string out;
+  out.reserve(text.size() / 4 * 3);
+
+  uint32_t chunk = 0;
+  int bits = 0;
+  size_t padding = 0;
+  for (char c : text)
+  {
+    if (c == '=')
+    {
+      padding += 1;
+      continue;
+    }
+    else if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+    {
+      continue;
+    }
+
+    const int value = base64_value(c);
+    if (value < 0 || padding > 0)
+      throw std::runtime_error("invalid base64 in tile data");
+
+    chunk = (chunk << 6) | static_cast<uint32_t>(value);
+    bits += 6;
+    if (bits >= 8)
+    {
+      bits -= 8;
+      out += static_cast<char>((chunk >> bits) & 0xff);
+    }
+  }
+
+  if (padding > 2)
+    throw std::runtime_error("invalid base64 in tile data");
+
+  return out;
+}
+
+} // namespace
+
+std::string
+TileEncoding::encode(const std::vector<uint32_t>& tiles)
+{
+  return base64_encode(encode_runs(tiles.data(), tiles.size()));
+}
+
+std::vector<uint32_t>
+TileEncoding::decode(const std::string& text, size_t count)
+{
+  std::vector<uint32_t> tiles;
+  decode_runs(base64_decode(text), count, tiles);
+  return tiles;
+}
+
+std::string
+TileEncoding::encode_runs(const uint32_t* tiles, size_t count)
+{
+  std::string data;
+  for (size_t i = 0; i < count;)
+  {
+    size_t run = 1;
+    while (i + run < count && tiles[i + run] == tiles[i] && run < 0xffffffffu)
+      ++run;
+
+    write_varint(data, static_cast<uint32_t>(run));
+    write_varint(data, tiles[i]);
+    i += run;
+  }
+  return data;
+}
+
+void
+TileEncoding::decode_runs(const std::string& data, size_t count, std::vector<uint32_t>& tiles)
+{
+  // check the runs before allocating anything, \a count comes from
+  // the level file as well and may be far off the actual data
+  size_t total = 0;
+  size_t pos = 0;
+  while (pos < data.size())
+  {
+    const uint32_t run = read_varint(data, pos);
+    read_varint(data, pos);
+    if (run == 0)
+      throw std::runtime_error("empty run in tile data");
+    if (run > count - total)
+      throw std::runtime_error("too many tiles in tile data");
+    total += run;
+  }
+
+  if (total != count)
+    throw std::runtime_error("too few tiles in tile data");
+
+  tiles.reserve(tiles.size() + count);
+  pos = 0;
+  while (pos < data.size())
+  {
+    const uint32_t run = read_varint(data, pos);
+    const uint32_t id = read_varint(data, pos);
+    tiles.insert(tiles.end(), run, id);
+  }
+}
+
+/* EOF */
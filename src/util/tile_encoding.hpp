@@ -0,0 +1,52 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_TILE_ENCODING_HPP
+#define HEADER_SUPERTUX_UTIL_TILE_ENCODING_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/** Compact text encoding for tile ids: runs of equal ids are stored
+    as (length, id) pairs of varints, the result is base64 encoded so
+    that it can be written as a string. Tilemaps are dominated by long
+    runs of 0 or of the same id, so this is much smaller than writing
+    every id as a number. */
+class TileEncoding final
+{
+public:
+  static std::string encode(const std::vector<uint32_t>& tiles);
+
+  /** Throws std::runtime_error when \a text is malformed or doesn't
+      hold exactly \a count tiles */
+  static std::vector<uint32_t> decode(const std::string& text, size_t count);
+
+  /** The run-length part of encode() without the base64 step, for
+      data that stays in memory */
+  static std::string encode_runs(const uint32_t* tiles, size_t count);
+
+  /** Appends the tiles of data written by encode_runs() to \a tiles,
+      throws std::runtime_error when \a data is malformed or doesn't
+      hold exactly \a count tiles; the data is checked before
+      anything gets allocated */
+  static void decode_runs(const std::string& data, size_t count, std::vector<uint32_t>& tiles);
+};
+
+#endif
+
+/* EOF */
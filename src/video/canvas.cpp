@@ -30,7 +30,8 @@
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_has_displacement(false)
 {
 }
 
@@ -47,6 +48,7 @@ Canvas::clear()
     request->~DrawingRequest();
   }
   m_requests.clear();
+  m_has_displacement = false;
 }
 
 void
@@ -131,6 +133,7 @@ Canvas::draw_surface(SurfacePtr surface,
   request->dstrects.emplace_back(Rectf(apply_translate(position), Size(surface->get_width(), surface->get_height())));
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
+  m_has_displacement |= (request->displacement_texture != nullptr);
   request->color = color;
 
   m_requests.push_back(request);
@@ -168,6 +171,7 @@ Canvas::draw_surface_part(SurfacePtr surface, const Rectf& srcrect, const Rectf&
   request->dstrects.emplace_back(apply_translate(dstrect.p1), dstrect.get_size());
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
+  m_has_displacement |= (request->displacement_texture != nullptr);
   request->color = style.get_color();
 
   m_requests.push_back(request);
@@ -199,6 +203,7 @@ Canvas::draw_surface_batch(SurfacePtr surface,
 
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
+  m_has_displacement |= (request->displacement_texture != nullptr);
 
   m_requests.push_back(request);
 }
@@ -85,6 +85,10 @@ public:
 
   DrawingContext& get_context() { return m_context; }
 
+  /** Whether a request samples the back buffer through a
+      displacement texture */
+  bool has_displacement() const { return m_has_displacement; }
+
 private:
   Vector apply_translate(const Vector& pos) const;
 
@@ -92,6 +96,7 @@ private:
   DrawingContext& m_context;
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
+  bool m_has_displacement;
 
 private:
   Canvas(const Canvas&) = delete;
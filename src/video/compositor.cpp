@@ -79,8 +79,13 @@ Compositor::render()
     lightmap.end_draw();
   }
 
+  // the back buffer is only sampled by displacement textures
   auto back_renderer = m_video_system.get_back_renderer();
-  if (back_renderer)
+  if (back_renderer &&
+      std::any_of(m_drawing_contexts.begin(), m_drawing_contexts.end(),
+                  [](std::unique_ptr<DrawingContext>& ctx){
+                    return ctx->color().has_displacement();
+                  }))
   {
     back_renderer->start_draw();
 
@@ -96,45 +101,61 @@ Compositor::render()
     back_renderer->end_draw();
   }
 
-  // compose the screen
+  // render the scene below native resolution, overlay contexts
+  // are left out and drawn directly to the screen
+  auto scene_renderer = m_video_system.get_scene_renderer();
+  if (scene_renderer)
   {
-    auto& renderer = m_video_system.get_renderer();
+    scene_renderer->start_draw();
 
-    renderer.start_draw();
-    Painter& painter = renderer.get_painter();
+    Painter& painter = scene_renderer->get_painter();
+    painter.clear(Color::BLACK);
 
     for(auto& ctx : m_drawing_contexts)
     {
-      painter.set_clip_rect(ctx->get_viewport());
-      ctx->color().render(renderer, Canvas::BELOW_LIGHTMAP);
-      painter.clear_clip_rect();
+      if (!ctx->is_overlay())
+      {
+        painter.set_clip_rect(ctx->get_viewport());
+        ctx->color().render(*scene_renderer, Canvas::BELOW_LIGHTMAP);
+        painter.clear_clip_rect();
+      }
     }
 
     if (use_lightmap)
     {
-      const TexturePtr& texture = lightmap.get_texture();
-      if (texture)
-      {
-        TextureRequest request;
+      draw_texture(painter, lightmap, Blend::MOD);
+    }
 
-        request.type = TEXTURE;
-        request.flip = 0;
-        request.alpha = 1.0f;
-        request.angle = 0.0f;
-        request.blend = Blend::MOD;
+    scene_renderer->end_draw();
+  }
 
-        request.srcrects.emplace_back(0, 0,
-                                      static_cast<float>(texture->get_image_width()),
-                                      static_cast<float>(texture->get_image_height()));
-        request.dstrects.emplace_back(Vector(0, 0), lightmap.get_logical_size());
+  // compose the screen
+  {
+    auto& renderer = m_video_system.get_renderer();
 
-        request.texture = texture.get();
-        request.color = Color::WHITE;
+    renderer.start_draw();
+    Painter& painter = renderer.get_painter();
 
-        painter.draw_texture(request);
+    if (scene_renderer)
+    {
+      draw_texture(painter, *scene_renderer, Blend::NONE);
+    }
+
+    for(auto& ctx : m_drawing_contexts)
+    {
+      if (!scene_renderer || ctx->is_overlay())
+      {
+        painter.set_clip_rect(ctx->get_viewport());
+        ctx->color().render(renderer, Canvas::BELOW_LIGHTMAP);
+        painter.clear_clip_rect();
       }
     }
 
+    if (use_lightmap && !scene_renderer)
+    {
+      draw_texture(painter, lightmap, Blend::MOD);
+    }
+
     // Render overlay elements
     for(auto& ctx : m_drawing_contexts)
     {
@@ -151,10 +172,35 @@ Compositor::render()
   {
     ctx->clear();
   }
-  m_video_system.flip();
 
   obstack_free(&m_obst, nullptr);
   obstack_init(&m_obst);
 }
 
+void
+Compositor::draw_texture(Painter& painter, const Renderer& source, const Blend& blend)
+{
+  const TexturePtr& texture = source.get_texture();
+  if (!texture)
+    return;
+
+  TextureRequest request;
+
+  request.type = TEXTURE;
+  request.flip = 0;
+  request.alpha = 1.0f;
+  request.angle = 0.0f;
+  request.blend = blend;
+
+  request.srcrects.emplace_back(0, 0,
+                                static_cast<float>(texture->get_image_width()),
+                                static_cast<float>(texture->get_image_height()));
+  request.dstrects.emplace_back(Vector(0, 0), source.get_logical_size());
+
+  request.texture = texture.get();
+  request.color = Color::WHITE;
+
+  painter.draw_texture(request);
+}
+
 /* EOF */
@@ -22,8 +22,11 @@
 
 #include "util/obstackpp.hpp"
 
+class Blend;
 class DrawingContext;
+class Painter;
 class Rect;
+class Renderer;
 class VideoSystem;
 
 class Compositor final
@@ -36,6 +39,8 @@ public:
   Compositor(VideoSystem& video_system);
   ~Compositor();
 
+  /** Render all contexts, the result has to be shown with
+      VideoSystem::flip() afterwards */
   void render();
 
   /** Create a DrawingContext, if overlay is true the context will not
@@ -44,6 +49,10 @@ public:
       otherwise their lighting would get messed up. */
   DrawingContext& make_context(bool overlay = false);
 
+private:
+  /** Draw the result of \a source over the whole screen */
+  void draw_texture(Painter& painter, const Renderer& source, const Blend& blend);
+
 private:
   VideoSystem& m_video_system;
 
@@ -0,0 +1,101 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/dynamic_resolution.hpp"
+
+#include <algorithm>
+
+const float DynamicResolution::s_min_scale = 0.5f;
+const float DynamicResolution::s_scale_step = 0.125f;
+const int DynamicResolution::s_settle_frames = 30;
+
+namespace {
+
+/** Weight of the newest frame in the moving average */
+const float s_smoothing = 0.1f;
+
+/** Scale is lowered when the average goes above this part of the
+    budget, leaving a bit of room for spikes */
+const float s_upper_threshold = 0.9f;
+
+/** Scale is raised only when the estimated frame time at the next
+    step stays below this part of the budget */
+const float s_lower_threshold = 0.8f;
+
+} // namespace
+
+DynamicResolution::DynamicResolution() :
+  m_budget(1.0f / 60.0f),
+  m_average(0.0f),
+  m_scale(1.0f),
+  m_frames(0)
+{
+}
+
+void
+DynamicResolution::set_budget(float budget)
+{
+  m_budget = budget;
+}
+
+void
+DynamicResolution::update(float frame_time)
+{
+  if (m_average == 0.0f)
+  {
+    // first frame after a reset
+    m_average = frame_time;
+  }
+  else
+  {
+    m_average += (frame_time - m_average) * s_smoothing;
+  }
+
+  m_frames += 1;
+  if (m_frames < s_settle_frames)
+    return;
+
+  if (m_average > m_budget * s_upper_threshold)
+  {
+    if (m_scale > s_min_scale)
+    {
+      m_scale = std::max(s_min_scale, m_scale - s_scale_step);
+      m_frames = 0;
+    }
+  }
+  else if (m_scale < 1.0f)
+  {
+    // drawing cost grows with the number of pixels, so estimate the
+    // frame time at the next step before raising the scale
+    const float next_scale = std::min(1.0f, m_scale + s_scale_step);
+    const float ratio = next_scale / m_scale;
+    if (m_average * ratio * ratio < m_budget * s_lower_threshold)
+    {
+      m_scale = next_scale;
+      m_frames = 0;
+    }
+  }
+}
+
+void
+DynamicResolution::reset()
+{
+  m_average = 0.0f;
+  m_scale = 1.0f;
+  m_frames = 0;
+}
+
+/* EOF */
@@ -0,0 +1,67 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_DYNAMIC_RESOLUTION_HPP
+#define HEADER_SUPERTUX_VIDEO_DYNAMIC_RESOLUTION_HPP
+
+/** Picks the resolution the scene is rendered at from the time it
+    takes to draw a frame. When frames take longer than the budget
+    the scale is lowered step by step, when there is enough headroom
+    for the next step it is raised again. */
+class DynamicResolution final
+{
+public:
+  /** Lowest scale the scene is rendered at, relative to the native
+      resolution of the window */
+  static const float s_min_scale;
+
+  /** Amount by which the scale is changed at once */
+  static const float s_scale_step;
+
+  /** Number of frames to wait after a change before the next one, so
+      that the average frame time can settle */
+  static const int s_settle_frames;
+
+public:
+  DynamicResolution();
+
+  /** Set the time in seconds that drawing a frame may take */
+  void set_budget(float budget);
+  float get_budget() const { return m_budget; }
+
+  /** Feed the time in seconds it took to draw the last frame */
+  void update(float frame_time);
+
+  /** Go back to native resolution and forget the frame history */
+  void reset();
+
+  float get_scale() const { return m_scale; }
+  float get_average_frame_time() const { return m_average; }
+
+private:
+  float m_budget;
+  float m_average;
+  float m_scale;
+  int m_frames;
+
+private:
+  DynamicResolution(const DynamicResolution&) = delete;
+  DynamicResolution& operator=(const DynamicResolution&) = delete;
+};
+
+#endif
+
+/* EOF */
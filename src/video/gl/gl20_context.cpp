@@ -32,7 +32,7 @@ GL20Context::~GL20Context()
 }
 
 void
-GL20Context::bind()
+GL20Context::bind(const Rect&, bool)
 {
   glDisable(GL_DEPTH_TEST);
   glDisable(GL_CULL_FACE);
@@ -27,7 +27,7 @@ public:
   GL20Context();
   ~GL20Context();
 
-  virtual void bind() override;
+  virtual void bind(const Rect& target_rect, bool vflip) override;
 
   virtual void ortho(float width, float height, bool vflip) override;
 
@@ -16,6 +16,7 @@
 
 #include "video/gl/gl33core_context.hpp"
 
+#include "math/rect.hpp"
 #include "supertux/globals.hpp"
 #include "video/color.hpp"
 #include "video/gl/gl_program.hpp"
@@ -46,7 +47,7 @@ GL33CoreContext::~GL33CoreContext()
 }
 
 void
-GL33CoreContext::bind()
+GL33CoreContext::bind(const Rect& target_rect, bool vflip)
 {
   glDisable(GL_DEPTH_TEST);
   glDisable(GL_CULL_FACE);
@@ -80,12 +81,17 @@ GL33CoreContext::bind()
     static_cast<float>(texture->get_image_height()) /
     static_cast<float>(texture->get_texture_height());
 
-  const Rect& rect = m_video_system.get_viewport().get_rect();
+  const Rect& rect = target_rect;
 
   const float sx = tsx / static_cast<float>(rect.get_width());
-  const float sy = tsy / static_cast<float>(rect.get_height());
   const float tx = -static_cast<float>(rect.left) / static_cast<float>(rect.get_width());
-  const float ty = -static_cast<float>(rect.top) / static_cast<float>(rect.get_height());
+
+  // offscreen targets are upside down compared to the screen, flip
+  // them so that the framebuffer texture is sampled at the same spot
+  const float sy = tsy / static_cast<float>(rect.get_height()) * (vflip ? 1.0f : -1.0f);
+  const float ty = vflip ?
+    -static_cast<float>(rect.top) / static_cast<float>(rect.get_height()) :
+    tsy;
 
   const float matrix[3*3] = {
     sx, 0.0, 0,
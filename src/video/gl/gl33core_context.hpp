@@ -32,7 +32,7 @@ public:
   GL33CoreContext(GLVideoSystem& video_system);
   ~GL33CoreContext();
 
-  virtual void bind() override;
+  virtual void bind(const Rect& target_rect, bool vflip) override;
 
   virtual void ortho(float width, float height, bool vflip) override;
 
@@ -22,6 +22,7 @@
 #include "video/gl.hpp"
 
 class Color;
+class Rect;
 class GLTexture;
 class Texture;
 
@@ -31,7 +32,10 @@ public:
   GLContext() {}
   virtual ~GLContext() {}
 
-  virtual void bind() = 0;
+  /** Prepare the context for drawing into \a target_rect of the
+      current framebuffer, \a vflip is true for the screen and false
+      for offscreen textures */
+  virtual void bind(const Rect& target_rect, bool vflip) = 0;
 
   virtual void ortho(float width, float height, bool vflip) = 0;
 
@@ -30,6 +30,7 @@
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 #include "video/renderer.hpp"
+#include "video/texture_manager.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -46,6 +47,15 @@ GLPainter::draw_texture(const TextureRequest& request)
 
   const auto& texture = static_cast<const GLTexture&>(*request.texture);
 
+  // evicted textures that can't be paged in right now are skipped for
+  // this frame
+  if (!TextureManager::current()->use(texture) ||
+      (request.displacement_texture &&
+       !TextureManager::current()->use(*request.displacement_texture)))
+  {
+    return;
+  }
+
   assert(request.srcrects.size() == request.dstrects.size());
 
   std::vector<float> vertices;
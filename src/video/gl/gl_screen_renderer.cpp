@@ -42,14 +42,14 @@ GLScreenRenderer::start_draw()
 {
   assert_gl();
 
+  const Viewport& viewport = m_video_system.get_viewport();
+  const Rect& rect = viewport.get_rect();
+
   GLContext& context = m_video_system.get_context();
-  context.bind();
+  context.bind(rect, true);
 
   context.blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-  const Viewport& viewport = m_video_system.get_viewport();
-  const Rect& rect = viewport.get_rect();
-
   glViewport(rect.left, rect.top, rect.get_width(), rect.get_height());
 
   context.ortho(static_cast<float>(viewport.get_screen_width()),
@@ -28,7 +28,8 @@ GLTexture::GLTexture(int width, int height, boost::optional<Color> fill_color) :
   m_texture_width(),
   m_texture_height(),
   m_image_width(),
-  m_image_height()
+  m_image_height(),
+  m_format()
 {
 #ifdef GL_VERSION_ES_CM_1_0
   assert(is_power_of_2(width));
@@ -70,7 +71,8 @@ GLTexture::GLTexture(const SDL_Surface& image, const Sampler& sampler) :
   m_texture_width(),
   m_texture_height(),
   m_image_width(),
-  m_image_height()
+  m_image_height(),
+  m_format()
 {
   if (gl_needs_power_of_two())
   {
@@ -86,6 +88,17 @@ GLTexture::GLTexture(const SDL_Surface& image, const Sampler& sampler) :
   m_image_width  = image.w;
   m_image_height = image.h;
 
+  upload(image);
+}
+
+GLTexture::~GLTexture()
+{
+  glDeleteTextures(1, &m_handle);
+}
+
+void
+GLTexture::upload(const SDL_Surface& image)
+{
   SDLSurfacePtr convert = SDLSurface::create_rgba(m_texture_width, m_texture_height);
 
   SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
@@ -95,34 +108,59 @@ GLTexture::GLTexture(const SDL_Surface& image, const Sampler& sampler) :
   glGenTextures(1, &m_handle);
 
   try {
-    GLenum sdl_format;
-    if(convert->format->BytesPerPixel == 3)
-      sdl_format = GL_RGB;
-    else if(convert->format->BytesPerPixel == 4)
-      sdl_format = GL_RGBA;
-    else {
-      sdl_format = GL_RGBA;
-      assert(false);
+    if(SDL_MUSTLOCK(convert))
+    {
+      SDL_LockSurface(convert.get());
+    }
+
+    const uint8_t* pixels = static_cast<const uint8_t*>(convert->pixels);
+    if (!m_format)
+    {
+      m_format = choose_texture_format(pixels, m_texture_width, m_texture_height, convert->pitch);
     }
 
     glBindTexture(GL_TEXTURE_2D, m_handle);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (*m_format == TextureFormat::RGBA8888)
+    {
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 #if defined(GL_UNPACK_ROW_LENGTH) || defined(USE_GLBINDING)
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, convert->pitch/convert->format->BytesPerPixel);
+      glPixelStorei(GL_UNPACK_ROW_LENGTH, convert->pitch/convert->format->BytesPerPixel);
 #else
-    /* OpenGL ES doesn't support UNPACK_ROW_LENGTH, let's hope SDL didn't add
-     * padding bytes, otherwise we need some extra code here... */
-    assert(convert->pitch == static_cast<int>(m_texture_width * convert->format->BytesPerPixel));
+      /* OpenGL ES doesn't support UNPACK_ROW_LENGTH, let's hope SDL didn't add
+       * padding bytes, otherwise we need some extra code here... */
+      assert(convert->pitch == static_cast<int>(m_texture_width * convert->format->BytesPerPixel));
 #endif
 
-    if(SDL_MUSTLOCK(convert))
-    {
-      SDL_LockSurface(convert.get());
+      glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(GL_RGBA),
+                   m_texture_width, m_texture_height, 0, GL_RGBA,
+                   GL_UNSIGNED_BYTE, pixels);
     }
+    else
+    {
+      // the packed pixels have no padding between the rows
+      std::vector<uint16_t> packed = pack_pixels(*m_format, pixels, m_texture_width, m_texture_height,
+                                                 convert->pitch);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(GL_RGBA),
-                 m_texture_width, m_texture_height, 0, sdl_format,
-                 GL_UNSIGNED_BYTE, convert->pixels);
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+#if defined(GL_UNPACK_ROW_LENGTH) || defined(USE_GLBINDING)
+      glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+
+      const bool rgb565 = (*m_format == TextureFormat::RGB565);
+      const GLenum format = rgb565 ? GL_RGB : GL_RGBA;
+      const GLenum type = rgb565 ? GL_UNSIGNED_SHORT_5_6_5 : GL_UNSIGNED_SHORT_4_4_4_4;
+#if defined(USE_OPENGLES2) || defined(USE_OPENGLES1)
+      // OpenGL ES wants the internal format to match the format
+      const GLenum internal_format = format;
+#else
+      const GLenum internal_format = rgb565 ? GL_RGB5 : GL_RGBA4;
+#endif
+
+      glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(internal_format),
+                   m_texture_width, m_texture_height, 0, format,
+                   type, packed.data());
+    }
 
     // no not use mipmaps
     if(false)
@@ -140,13 +178,24 @@ GLTexture::GLTexture(const SDL_Surface& image, const Sampler& sampler) :
     set_texture_params();
   } catch(...) {
     glDeleteTextures(1, &m_handle);
+    m_handle = 0;
     throw;
   }
 }
 
-GLTexture::~GLTexture()
+void
+GLTexture::release()
 {
   glDeleteTextures(1, &m_handle);
+  m_handle = 0;
+}
+
+void
+GLTexture::reload(const SDL_Surface& image)
+{
+  assert(m_handle == 0);
+  assert(image.w == m_image_width && image.h == m_image_height);
+  upload(image);
 }
 
 void
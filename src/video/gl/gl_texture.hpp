@@ -23,6 +23,7 @@
 #include "video/gl.hpp"
 #include "video/sampler.hpp"
 #include "video/texture.hpp"
+#include "video/texture_format.hpp"
 
 class Sampler;
 
@@ -39,6 +40,10 @@ protected:
   int m_image_width;
   int m_image_height;
 
+  /** picked on the first upload and kept when the texture gets
+      reloaded after an eviction */
+  boost::optional<TextureFormat> m_format;
+
 public:
   GLTexture(int width, int height, boost::optional<Color> fill_color = boost::none);
   GLTexture(const SDL_Surface& image, const Sampler& sampler);
@@ -77,6 +82,11 @@ public:
     return m_image_height;
   }
 
+  virtual int get_bytes_per_pixel() const override
+  {
+    return m_format ? ::get_bytes_per_pixel(*m_format) : 4;
+  }
+
   void set_image_width(int width)
   {
     m_image_width = width;
@@ -88,6 +98,10 @@ public:
   }
 
 private:
+  virtual void release() override;
+  virtual void reload(const SDL_Surface& image) override;
+
+  void upload(const SDL_Surface& image);
   void set_texture_params();
 };
 
@@ -17,6 +17,7 @@
 
 #include "video/gl/gl_texture_renderer.hpp"
 
+#include "math/rect.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "video/drawing_request.hpp"
@@ -30,7 +31,7 @@
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
-GLTextureRenderer::GLTextureRenderer(GLVideoSystem& video_system, const Size& size, int downscale) :
+GLTextureRenderer::GLTextureRenderer(GLVideoSystem& video_system, const Size& size, float downscale) :
   m_video_system(video_system),
   m_painter(m_video_system, *this),
   m_size(size),
@@ -50,8 +51,8 @@ GLTextureRenderer::prepare()
 {
   if (!m_texture)
   {
-    m_texture.reset(new GLTexture(m_size.width / m_downscale,
-                                  m_size.height / m_downscale));
+    m_texture.reset(new GLTexture(static_cast<int>(static_cast<float>(m_size.width) / m_downscale),
+                                  static_cast<int>(static_cast<float>(m_size.height) / m_downscale)));
 
     if (m_video_system.get_context().supports_framebuffer())
     {
@@ -76,7 +77,7 @@ GLTextureRenderer::start_draw()
   prepare();
 
   GLContext& context = m_video_system.get_context();
-  context.bind();
+  context.bind(Rect(0, 0, m_texture->get_image_width(), m_texture->get_image_height()), false);
 
   if (m_framebuffer)
   {
@@ -35,7 +35,7 @@ struct DrawingRequest;
 class GLTextureRenderer final : public Renderer
 {
 public:
-  GLTextureRenderer(GLVideoSystem& video_system, const Size& size, int downscale);
+  GLTextureRenderer(GLVideoSystem& video_system, const Size& size, float downscale);
   ~GLTextureRenderer();
 
   virtual void start_draw() override;
@@ -58,7 +58,7 @@ private:
   GLPainter m_painter;
 
   Size m_size;
-  int m_downscale;
+  float m_downscale;
   TexturePtr m_texture;
   std::unique_ptr<GLFramebuffer> m_framebuffer;
   bool m_rendering;
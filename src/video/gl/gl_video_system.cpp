@@ -45,6 +45,8 @@ GLVideoSystem::GLVideoSystem(bool use_opengl33core) :
   m_texture_manager(),
   m_renderer(),
   m_lightmap(),
+  m_scene_renderer(),
+  m_scene_scale(1.0f),
   m_back_renderer(),
   m_context(),
   m_window(),
@@ -247,11 +249,9 @@ GLVideoSystem::apply_config()
 
   m_viewport = Viewport::from_size(target_size, m_desktop_size);
 
-  m_lightmap.reset(new GLTextureRenderer(*this, m_viewport.get_screen_size(), 5));
-  if (m_use_opengl33core)
-  {
-    m_back_renderer.reset(new GLTextureRenderer(*this, m_viewport.get_screen_size(), 1));
-  }
+  m_lightmap.reset(new GLTextureRenderer(*this, m_viewport.get_screen_size(),
+                                         get_lightmap_downscale(m_viewport)));
+  create_scene_renderer();
 }
 
 void
@@ -321,6 +321,44 @@ GLVideoSystem::get_lightmap() const
   return *m_lightmap;
 }
 
+Renderer*
+GLVideoSystem::get_scene_renderer() const
+{
+  return m_scene_renderer.get();
+}
+
+void
+GLVideoSystem::set_scene_scale(float scale)
+{
+  if (scale == m_scene_scale)
+    return;
+
+  m_scene_scale = scale;
+  create_scene_renderer();
+}
+
+void
+GLVideoSystem::create_scene_renderer()
+{
+  if (m_scene_scale < 1.0f)
+  {
+    m_scene_renderer.reset(new GLTextureRenderer(*this, m_viewport.get_screen_size(),
+                                                 get_scene_downscale(m_viewport, m_scene_scale)));
+  }
+  else
+  {
+    m_scene_renderer.reset();
+  }
+
+  // the back buffer only feeds displacement effects within the scene,
+  // so it doesn't need more resolution than the scene itself
+  if (m_use_opengl33core)
+  {
+    m_back_renderer.reset(new GLTextureRenderer(*this, m_viewport.get_screen_size(),
+                                                m_scene_renderer ? get_scene_downscale(m_viewport, m_scene_scale) : 1.0f));
+  }
+}
+
 Renderer*
 GLVideoSystem::get_back_renderer() const
 {
@@ -333,6 +371,12 @@ GLVideoSystem::new_texture(const SDL_Surface& image, const Sampler& sampler)
   return TexturePtr(new GLTexture(image, sampler));
 }
 
+std::unique_ptr<Renderer>
+GLVideoSystem::new_texture_renderer(const Size& size, int downscale)
+{
+  return std::make_unique<GLTextureRenderer>(*this, size, downscale);
+}
+
 void
 GLVideoSystem::flip()
 {
@@ -340,6 +384,13 @@ GLVideoSystem::flip()
   SDL_GL_SwapWindow(m_window);
 }
 
+void
+GLVideoSystem::finish()
+{
+  glFinish();
+  assert_gl();
+}
+
 void
 GLVideoSystem::on_resize(int w, int h)
 {
@@ -44,12 +44,16 @@ public:
   virtual Renderer* get_back_renderer() const override;
   virtual Renderer& get_renderer() const override;
   virtual Renderer& get_lightmap() const override;
+  virtual Renderer* get_scene_renderer() const override;
+  virtual void set_scene_scale(float scale) override;
 
   virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler& sampler) override;
+  virtual std::unique_ptr<Renderer> new_texture_renderer(const Size& size, int downscale) override;
 
   virtual const Viewport& get_viewport() const override { return m_viewport; }
   virtual void apply_config() override;
   virtual void flip() override;
+  virtual void finish() override;
   virtual void on_resize(int w, int h) override;
 
   virtual void set_vsync(int mode) override;
@@ -67,12 +71,15 @@ public:
 private:
   void create_window();
   void apply_video_mode();
+  void create_scene_renderer();
 
 private:
   bool m_use_opengl33core;
   std::unique_ptr<TextureManager> m_texture_manager;
   std::unique_ptr<GLScreenRenderer> m_renderer;
   std::unique_ptr<GLTextureRenderer> m_lightmap;
+  std::unique_ptr<GLTextureRenderer> m_scene_renderer;
+  float m_scene_scale;
   std::unique_ptr<GLTextureRenderer> m_back_renderer;
   std::unique_ptr<GLContext> m_context;
 
@@ -0,0 +1,160 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/image_cache.hpp"
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <stdint.h>
+#include <string.h>
+
+#include "physfs/physfs_cache_file.hpp"
+#include "video/sdl_surface.hpp"
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'I', 'C' };
+const uint32_t VERSION = 1;
+
+struct Header
+{
+  char magic[4];
+  uint32_t version;
+  int64_t modtime;
+  int64_t filesize;
+  int32_t width;
+  int32_t height;
+  uint32_t path_length;
+};
+
+// the header is written as is, a change of its layout needs a new VERSION
+static_assert(sizeof(Header) == 40, "cache header layout changed");
+
+} // namespace
+
+ImageCache::ImageCache(const std::string& directory) :
+  m_directory(directory)
+{
+  PHYSFS_mkdir(m_directory.c_str());
+}
+
+std::string
+ImageCache::get_cache_filename(const std::string& filename) const
+{
+  // collisions are caught by comparing the path stored in the header
+  std::ostringstream out;
+  out << m_directory << "/" << std::hex << std::setw(16) << std::setfill('0')
+      << std::hash<std::string>()(filename) << ".img";
+  return out.str();
+}
+
+SDLSurfacePtr
+ImageCache::load(const std::string& filename) const
+{
+  PHYSFS_Stat statbuf;
+  if (!PhysFSCacheFile::stat_source(filename, statbuf))
+    return {};
+
+  const std::string cache_filename = get_cache_filename(filename);
+  if (!PHYSFS_exists(cache_filename.c_str()))
+    return {};
+
+  PHYSFSFilePtr file = PhysFSCacheFile::open_read(cache_filename);
+  if (!file)
+    return {};
+
+  Header header;
+  if (PHYSFS_readBytes(file.get(), &header, sizeof(header)) != sizeof(header) ||
+      memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION ||
+      header.modtime != statbuf.modtime ||
+      header.filesize != statbuf.filesize ||
+      header.path_length != filename.size() ||
+      header.width <= 0 || header.height <= 0)
+  {
+    return {};
+  }
+
+  std::string path(header.path_length, '\0');
+  if (PHYSFS_readBytes(file.get(), &path[0], path.size()) != static_cast<PHYSFS_sint64>(path.size()) ||
+      path != filename)
+  {
+    return {};
+  }
+
+  SDLSurfacePtr image = SDLSurface::create_rgba(header.width, header.height);
+
+  const PHYSFS_uint64 row_size = static_cast<PHYSFS_uint64>(header.width) * 4;
+  auto pixels = static_cast<uint8_t*>(image->pixels);
+  if (static_cast<PHYSFS_uint64>(image->pitch) == row_size)
+  {
+    const PHYSFS_uint64 size = row_size * static_cast<PHYSFS_uint64>(header.height);
+    if (PHYSFS_readBytes(file.get(), pixels, size) != static_cast<PHYSFS_sint64>(size))
+      return {};
+  }
+  else
+  {
+    for(int y = 0; y < header.height; ++y)
+    {
+      if (PHYSFS_readBytes(file.get(), pixels + y * image->pitch, row_size) != static_cast<PHYSFS_sint64>(row_size))
+        return {};
+    }
+  }
+
+  return image;
+}
+
+void
+ImageCache::store(const std::string& filename, const SDL_Surface& image) const
+{
+  PHYSFS_Stat statbuf;
+  if (!PhysFSCacheFile::stat_source(filename, statbuf))
+    return;
+
+  // convert to the format load() hands out
+  SDLSurfacePtr rgba = SDLSurface::create_rgba(image.w, image.h);
+  SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
+  SDL_BlitSurface(const_cast<SDL_Surface*>(&image), nullptr, rgba.get(), nullptr);
+
+  PHYSFSFilePtr file = PhysFSCacheFile::open_write(get_cache_filename(filename));
+  if (!file)
+    return;
+
+  // the padding bytes end up in the file as well
+  Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.modtime = statbuf.modtime;
+  header.filesize = statbuf.filesize;
+  header.width = rgba->w;
+  header.height = rgba->h;
+  header.path_length = static_cast<uint32_t>(filename.size());
+
+  PHYSFS_writeBytes(file.get(), &header, sizeof(header));
+  PHYSFS_writeBytes(file.get(), filename.data(), filename.size());
+
+  const PHYSFS_uint64 row_size = static_cast<PHYSFS_uint64>(rgba->w) * 4;
+  auto pixels = static_cast<const uint8_t*>(rgba->pixels);
+  for(int y = 0; y < rgba->h; ++y)
+  {
+    PHYSFS_writeBytes(file.get(), pixels + y * rgba->pitch, row_size);
+  }
+}
+
+/* EOF */
@@ -0,0 +1,60 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_IMAGE_CACHE_HPP
+#define HEADER_SUPERTUX_VIDEO_IMAGE_CACHE_HPP
+
+#include <string>
+
+#include "video/sdl_surface_ptr.hpp"
+
+struct SDL_Surface;
+
+/** Keeps decoded images as raw RGBA in the user directory, so that
+    they can be read back with a single copy instead of going through
+    the PNG decoder on the next start. Entries are keyed by path, file
+    size and modification time of the source image.
+
+    The methods don't log and don't touch shared state, so they can be
+    called from the image decoding threads. */
+class ImageCache final
+{
+public:
+  ImageCache(const std::string& directory);
+
+  /** Returns the cached image, or an empty pointer when there is no
+      valid entry for \a filename */
+  SDLSurfacePtr load(const std::string& filename) const;
+
+  /** Writes \a image as the cache entry for \a filename, failures are
+      silently ignored, as the cache is only an optimization */
+  void store(const std::string& filename, const SDL_Surface& image) const;
+
+private:
+  std::string get_cache_filename(const std::string& filename) const;
+
+private:
+  std::string m_directory;
+
+private:
+  ImageCache(const ImageCache&) = delete;
+  ImageCache& operator=(const ImageCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -28,6 +28,7 @@
 #include "video/renderer.hpp"
 #include "video/sdl/sdl_texture.hpp"
 #include "video/sdl/sdl_video_system.hpp"
+#include "video/texture_manager.hpp"
 #include "video/viewport.hpp"
 
 namespace {
@@ -212,6 +213,13 @@ SDLPainter::draw_texture(const TextureRequest& request)
 {
   const auto& texture = static_cast<const SDLTexture&>(*request.texture);
 
+  // evicted textures that can't be paged in right now are skipped for
+  // this frame
+  if (!TextureManager::current()->use(texture))
+  {
+    return;
+  }
+
   assert(request.srcrects.size() == request.dstrects.size());
 
   for(size_t i = 0; i < request.srcrects.size(); ++i)
@@ -17,6 +17,7 @@
 #include "video/sdl/sdl_texture.hpp"
 
 #include <SDL.h>
+#include <assert.h>
 #include <sstream>
 
 #include "video/sdl/sdl_screen_renderer.hpp"
@@ -35,6 +36,23 @@ SDLTexture::SDLTexture(const SDL_Surface& image, const Sampler& sampler) :
   m_width(),
   m_height(),
   m_sampler(sampler)
+{
+  upload(image);
+
+  m_width = image.w;
+  m_height = image.h;
+}
+
+SDLTexture::~SDLTexture()
+{
+  if (m_texture)
+  {
+    SDL_DestroyTexture(m_texture);
+  }
+}
+
+void
+SDLTexture::upload(const SDL_Surface& image)
 {
   m_texture = SDL_CreateTextureFromSurface(static_cast<SDLScreenRenderer&>(VideoSystem::current()->get_renderer()).get_sdl_renderer(),
                                            const_cast<SDL_Surface*>(&image));
@@ -44,14 +62,21 @@ SDLTexture::SDLTexture(const SDL_Surface& image, const Sampler& sampler) :
     msg << "couldn't create texture: " << SDL_GetError();
     throw std::runtime_error(msg.str());
   }
-
-  m_width = image.w;
-  m_height = image.h;
 }
 
-SDLTexture::~SDLTexture()
+void
+SDLTexture::release()
 {
   SDL_DestroyTexture(m_texture);
+  m_texture = nullptr;
+}
+
+void
+SDLTexture::reload(const SDL_Surface& image)
+{
+  assert(m_texture == nullptr);
+  assert(image.w == m_width && image.h == m_height);
+  upload(image);
 }
 
 /* EOF */
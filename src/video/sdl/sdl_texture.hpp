@@ -68,6 +68,17 @@ public:
     return m_height;
   }
 
+  virtual int get_bytes_per_pixel() const override
+  {
+    return 4;
+  }
+
+private:
+  virtual void release() override;
+  virtual void reload(const SDL_Surface& image) override;
+
+  void upload(const SDL_Surface& image);
+
 private:
   SDLTexture(const SDLTexture&);
   SDLTexture& operator=(const SDLTexture&);
@@ -27,7 +27,7 @@
 #include "video/sdl/sdl_video_system.hpp"
 #include "video/video_system.hpp"
 
-SDLTextureRenderer::SDLTextureRenderer(SDLVideoSystem& video_system, SDL_Renderer* renderer, const Size& size, int downscale) :
+SDLTextureRenderer::SDLTextureRenderer(SDLVideoSystem& video_system, SDL_Renderer* renderer, const Size& size, float downscale) :
   m_video_system(video_system),
   m_renderer(renderer),
   m_painter(m_video_system, *this, m_renderer),
@@ -52,8 +52,8 @@ SDLTextureRenderer::start_draw()
 {
   if (!m_texture)
   {
-    const int w = m_size.width / m_downscale;
-    const int h = m_size.height / m_downscale;
+    const int w = static_cast<int>(static_cast<float>(m_size.width) / m_downscale);
+    const int h = static_cast<int>(static_cast<float>(m_size.height) / m_downscale);
     SDL_Texture* sdl_texture = SDL_CreateTexture(m_renderer,
                                                  SDL_PIXELFORMAT_RGB888,
                                                  SDL_TEXTUREACCESS_TARGET,
@@ -70,8 +70,8 @@ SDLTextureRenderer::start_draw()
 
   SDL_SetRenderTarget(m_renderer, get_sdl_texture());
   SDL_RenderSetScale(m_renderer,
-                     1.0f / static_cast<float>(m_downscale),
-                     1.0f / static_cast<float>(m_downscale));
+                     1.0f / m_downscale,
+                     1.0f / m_downscale);
 }
 
 void
@@ -85,8 +85,8 @@ Rect
 SDLTextureRenderer::get_rect() const
 {
   return Rect(0, 0,
-              Size(m_size.width / m_downscale,
-                   m_size.height / m_downscale));
+              Size(static_cast<int>(static_cast<float>(m_size.width) / m_downscale),
+                   static_cast<int>(static_cast<float>(m_size.height) / m_downscale)));
 }
 
 Size
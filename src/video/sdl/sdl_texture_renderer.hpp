@@ -34,7 +34,7 @@ struct SDL_Texture;
 class SDLTextureRenderer final : public Renderer
 {
 public:
-  SDLTextureRenderer(SDLVideoSystem& video_system, SDL_Renderer* renderer, const Size& size, int downscale);
+  SDLTextureRenderer(SDLVideoSystem& video_system, SDL_Renderer* renderer, const Size& size, float downscale);
   ~SDLTextureRenderer();
 
   virtual void start_draw() override;
@@ -55,7 +55,7 @@ private:
   SDL_Renderer* m_renderer;
   SDLPainter m_painter;
   Size m_size;
-  int m_downscale;
+  float m_downscale;
 
   TexturePtr m_texture;
 
@@ -34,6 +34,8 @@ SDLVideoSystem::SDLVideoSystem() :
   m_viewport(),
   m_renderer(),
   m_lightmap(),
+  m_scene_renderer(),
+  m_scene_scale(1.0f),
   m_texture_manager()
 {
   SDL_DisplayMode mode;
@@ -105,7 +107,10 @@ SDLVideoSystem::apply_config()
     m_viewport = Viewport::from_size(target_size, m_desktop_size);
   }
 
-  m_lightmap.reset(new SDLTextureRenderer(*this, m_sdl_renderer, m_viewport.get_screen_size(), 5));
+  m_lightmap.reset(new SDLTextureRenderer(*this, m_sdl_renderer, m_viewport.get_screen_size(),
+                                          get_lightmap_downscale(m_viewport)));
+
+  create_scene_renderer();
 }
 
 void
@@ -175,12 +180,48 @@ SDLVideoSystem::get_lightmap() const
   return *m_lightmap;
 }
 
+Renderer*
+SDLVideoSystem::get_scene_renderer() const
+{
+  return m_scene_renderer.get();
+}
+
+void
+SDLVideoSystem::set_scene_scale(float scale)
+{
+  if (scale == m_scene_scale)
+    return;
+
+  m_scene_scale = scale;
+  create_scene_renderer();
+}
+
+void
+SDLVideoSystem::create_scene_renderer()
+{
+  if (m_scene_scale < 1.0f)
+  {
+    m_scene_renderer.reset(new SDLTextureRenderer(*this, m_sdl_renderer, m_viewport.get_screen_size(),
+                                                  get_scene_downscale(m_viewport, m_scene_scale)));
+  }
+  else
+  {
+    m_scene_renderer.reset();
+  }
+}
+
 TexturePtr
 SDLVideoSystem::new_texture(const SDL_Surface& image, const Sampler& sampler)
 {
   return TexturePtr(new SDLTexture(image, sampler));
 }
 
+std::unique_ptr<Renderer>
+SDLVideoSystem::new_texture_renderer(const Size& size, int downscale)
+{
+  return std::make_unique<SDLTextureRenderer>(*this, m_sdl_renderer, size, downscale);
+}
+
 void
 SDLVideoSystem::on_resize(int w, int h)
 {
@@ -226,6 +267,13 @@ SDLVideoSystem::flip()
   m_renderer->flip();
 }
 
+void
+SDLVideoSystem::finish()
+{
+  // SDL_Renderer offers no way to wait for the GPU, the software
+  // renderer has finished drawing at this point anyway
+}
+
 SDLSurfacePtr
 SDLVideoSystem::make_screenshot()
 {
@@ -37,12 +37,16 @@ public:
   virtual Renderer* get_back_renderer() const override { return nullptr; }
   virtual Renderer& get_renderer() const override;
   virtual Renderer& get_lightmap() const override;
+  virtual Renderer* get_scene_renderer() const override;
+  virtual void set_scene_scale(float scale) override;
 
   virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler& sampler) override;
+  virtual std::unique_ptr<Renderer> new_texture_renderer(const Size& size, int downscale) override;
 
   virtual const Viewport& get_viewport() const override { return m_viewport; }
   virtual void apply_config() override;
   virtual void flip() override;
+  virtual void finish() override;
   virtual void on_resize(int w, int h) override;
 
   virtual void set_vsync(int mode) override;
@@ -55,6 +59,7 @@ public:
 
 private:
   void apply_video_mode();
+  void create_scene_renderer();
 
 private:
   SDL_Window* m_sdl_window;
@@ -63,6 +68,8 @@ private:
   Viewport m_viewport;
   std::unique_ptr<SDLScreenRenderer> m_renderer;
   std::unique_ptr<SDLTextureRenderer> m_lightmap;
+  std::unique_ptr<SDLTextureRenderer> m_scene_renderer;
+  float m_scene_scale;
   std::unique_ptr<TextureManager> m_texture_manager;
 
 private:
@@ -113,6 +113,14 @@ Surface::from_texture(const TexturePtr& texture)
   return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP));
 }
 
+SurfacePtr
+Surface::from_textures(const TexturePtr& diffuse_texture,
+                       const TexturePtr& displacement_texture,
+                       Flip flip)
+{
+  return SurfacePtr(new Surface(diffuse_texture, displacement_texture, flip));
+}
+
 Surface::~Surface()
 {
 }
@@ -23,6 +23,8 @@
 
 #include "video/flip.hpp"
 
+struct SDL_Surface;
+
 /** This class is a wrapper around a texture handle. It stores the
     texture width and height and provides convenience functions for
     uploading SDL_Surfaces into the texture. */
@@ -35,6 +37,19 @@ public:
 private:
   boost::optional<Key> m_cache_key;
 
+  /** video memory taken by the texture, used for the TextureManager's
+      budget */
+  size_t m_memory_usage;
+
+  /** the TextureManager frame in which the texture was last used */
+  int m_last_used;
+
+  /** false for textures that can't be recreated from their cache key */
+  bool m_evictable;
+
+  /** false while the texture is evicted from video memory */
+  bool m_resident;
+
 protected:
   Texture();
 
@@ -46,6 +61,17 @@ public:
   virtual int get_image_width() const = 0;
   virtual int get_image_height() const = 0;
 
+  /** bytes a texel takes in video memory */
+  virtual int get_bytes_per_pixel() const = 0;
+
+private:
+  /** Frees the video memory of the texture, only its size is kept */
+  virtual void release() = 0;
+
+  /** Recreates a released texture from \a image, which has to have
+      the same size as the original image */
+  virtual void reload(const SDL_Surface& image) = 0;
+
 private:
   Texture(const Texture&);
   Texture& operator=(const Texture&);
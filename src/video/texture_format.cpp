@@ -0,0 +1,116 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/texture_format.hpp"
+
+#include <assert.h>
+#include <stddef.h>
+
+namespace {
+
+/** The reverse of the bit replication that is used to expand a
+    channel with \a bits bits back to eight bits */
+bool fits_bits(uint8_t value, int bits)
+{
+  const int shift = 8 - bits;
+  const int reduced = value >> shift;
+  const int expanded = (reduced << shift) | (reduced >> (bits - shift));
+  return expanded == value;
+}
+
+bool fits_rgb565(const uint8_t* p)
+{
+  return p[3] == 255 && fits_bits(p[0], 5) && fits_bits(p[1], 6) && fits_bits(p[2], 5);
+}
+
+bool fits_rgba4444(const uint8_t* p)
+{
+  return fits_bits(p[0], 4) && fits_bits(p[1], 4) && fits_bits(p[2], 4) && fits_bits(p[3], 4);
+}
+
+} // namespace
+
+int
+get_bytes_per_pixel(TextureFormat format)
+{
+  switch (format)
+  {
+    case TextureFormat::RGB565:
+    case TextureFormat::RGBA4444:
+      return 2;
+
+    default:
+      return 4;
+  }
+}
+
+TextureFormat
+choose_texture_format(const uint8_t* pixels, int width, int height, int pitch)
+{
+  bool rgb565 = true;
+  bool rgba4444 = true;
+
+  for (int y = 0; y < height && (rgb565 || rgba4444); ++y)
+  {
+    const uint8_t* row = pixels + y * pitch;
+    for (int x = 0; x < width; ++x)
+    {
+      const uint8_t* p = row + x * 4;
+      rgb565 = rgb565 && fits_rgb565(p);
+      rgba4444 = rgba4444 && fits_rgba4444(p);
+      if (!rgb565 && !rgba4444)
+        break;
+    }
+  }
+
+  if (rgb565)
+    return TextureFormat::RGB565;
+  else if (rgba4444)
+    return TextureFormat::RGBA4444;
+  else
+    return TextureFormat::RGBA8888;
+}
+
+std::vector<uint16_t>
+pack_pixels(TextureFormat format,
+            const uint8_t* pixels, int width, int height, int pitch)
+{
+  assert(format != TextureFormat::RGBA8888);
+
+  std::vector<uint16_t> result(static_cast<size_t>(width) * static_cast<size_t>(height));
+  auto out = result.begin();
+  for (int y = 0; y < height; ++y)
+  {
+    const uint8_t* row = pixels + y * pitch;
+    for (int x = 0; x < width; ++x)
+    {
+      const uint8_t* p = row + x * 4;
+      if (format == TextureFormat::RGB565)
+      {
+        *out++ = static_cast<uint16_t>(((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3));
+      }
+      else
+      {
+        *out++ = static_cast<uint16_t>(((p[0] >> 4) << 12) | ((p[1] >> 4) << 8) |
+                                       ((p[2] >> 4) << 4) | (p[3] >> 4));
+      }
+    }
+  }
+  return result;
+}
+
+/* EOF */
@@ -0,0 +1,47 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_FORMAT_HPP
+#define HEADER_SUPERTUX_VIDEO_TEXTURE_FORMAT_HPP
+
+#include <stdint.h>
+#include <vector>
+
+/** Pixel formats a texture can be stored in. The 16-bit formats are
+    only picked for images that they can represent without loss. */
+enum class TextureFormat
+{
+  RGBA8888,
+  RGB565,
+  RGBA4444
+};
+
+int get_bytes_per_pixel(TextureFormat format);
+
+/** Returns the smallest format that can hold every pixel of the
+    image unchanged. \a pixels are RGBA bytes in memory order, rows
+    are \a pitch bytes apart. */
+TextureFormat choose_texture_format(const uint8_t* pixels, int width, int height, int pitch);
+
+/** Converts the image to \a format, which has to be one of the
+    16-bit formats, the rows of the result are tightly packed */
+std::vector<uint16_t> pack_pixels(TextureFormat format,
+                                  const uint8_t* pixels, int width, int height, int pitch);
+
+#endif
+
+/* EOF */
@@ -17,17 +17,23 @@
 #include "video/texture_manager.hpp"
 
 #include <SDL_image.h>
+#include <algorithm>
 #include <assert.h>
 #include <sstream>
+#include <thread>
 
 #include "math/rect.hpp"
 #include "physfs/physfs_sdl.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/thread_pool.hpp"
 #include "video/color.hpp"
 #include "video/gl.hpp"
+#include "video/image_cache.hpp"
 #include "video/sampler.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture.hpp"
@@ -35,6 +41,75 @@
 
 namespace {
 
+/** textures unused for this many frames may get evicted */
+const int EVICT_FRAMES = 600;
+
+/** frames to wait before trying to evict again, when everything over
+    the budget is still in use */
+const int EVICT_INTERVAL = 60;
+
+/** limits how much gets uploaded in one frame, so that paging in
+    textures doesn't cause stutter */
+const size_t PAGE_IN_BUDGET = 8 * 1024 * 1024;
+
+/** time in milliseconds update() may spend on creating textures for
+    prefetched images */
+const Uint64 PAGE_IN_MILLISECONDS = 2;
+
+/** preloaded images that didn't get used for this many frames are
+    dropped */
+const int PRELOAD_FRAMES = 60;
+
+/** decoded images whose announced regions didn't get requested for
+    this many frames are dropped anyway */
+const int SURFACE_FRAMES = 600;
+
+int decoder_thread_count()
+{
+  // leave one core to the main thread
+  const int cores = static_cast<int>(std::thread::hardware_concurrency());
+  return std::max(1, std::min(cores - 1, 4));
+}
+
+/** Whether the key refers to a region cut from a bigger image */
+bool is_region(const Texture::Key& key)
+{
+  return std::get<3>(key) != std::get<1>(key) && std::get<4>(key) != std::get<2>(key);
+}
+
+size_t get_texel_count(const Texture& texture)
+{
+  return static_cast<size_t>(texture.get_texture_width()) *
+         static_cast<size_t>(texture.get_texture_height());
+}
+
+/** Runs on the worker threads, so unlike SDLSurface::from_file() it
+    must not log */
+SDLSurfacePtr decode_image(const std::string& filename, const ImageCache* cache)
+{
+  if (cache)
+  {
+    SDLSurfacePtr image = cache->load(filename);
+    if (image)
+      return image;
+  }
+
+  SDLSurfacePtr image(IMG_Load_RW(get_physfs_SDLRWops(filename), 1));
+  if (!image)
+  {
+    std::ostringstream msg;
+    msg << "Couldn't load image '" << filename << "' :" << SDL_GetError();
+    throw std::runtime_error(msg.str());
+  }
+
+  if (cache)
+  {
+    cache->store(filename, *image);
+  }
+
+  return image;
+}
+
 GLenum string2wrap(const std::string& text)
 {
   if (text == "clamp-to-edge")
@@ -77,7 +152,17 @@ GLenum string2filter(const std::string& text)
 
 TextureManager::TextureManager() :
   m_image_textures(),
-  m_surfaces()
+  m_image_cache(g_config->texture_cache ? new ImageCache("cache/images") : nullptr),
+  m_decoder(new ThreadPool(decoder_thread_count())),
+  m_pending_images(),
+  m_surfaces(),
+  m_frame(0),
+  m_next_eviction_frame(0),
+  m_resident_bytes(0),
+  m_saved_bytes(0),
+  m_page_in_bytes(0),
+  m_evicted_count(0),
+  m_prefetch()
 {
 }
 
@@ -91,13 +176,15 @@ TextureManager::~TextureManager()
     }
   }
   m_image_textures.clear();
+  m_decoder.reset();
+  m_pending_images.clear();
   m_surfaces.clear();
 }
 
-TexturePtr
-TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& region)
+void
+TextureManager::parse_texture(const ReaderMapping& mapping, std::string& filename,
+                              boost::optional<Rect>& rect, Sampler& sampler)
 {
-  std::string filename;
   if (!mapping.get("file", filename))
   {
     log_warning << "'file' tag missing" << std::endl;
@@ -107,7 +194,6 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     filename = FileSystem::join(mapping.get_doc().get_directory(), filename);
   }
 
-  boost::optional<Rect> rect;
   std::vector<int> rect_v;
   if (mapping.get("rect", rect_v))
   {
@@ -161,6 +247,17 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     }
   }
 
+  sampler = Sampler(filter, wrap_s, wrap_t, animate);
+}
+
+TexturePtr
+TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& region)
+{
+  std::string filename;
+  boost::optional<Rect> rect;
+  Sampler sampler;
+  parse_texture(mapping, filename, rect, sampler);
+
   if (region)
   {
     if (!rect)
@@ -177,7 +274,7 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     }
   }
 
-  return get(filename, rect, Sampler(filter, wrap_s, wrap_t, animate));
+  return get(filename, rect, sampler);
 }
 
 TexturePtr
@@ -193,7 +290,7 @@ TextureManager::get(const std::string& _filename)
 
   if(!texture) {
     texture = create_image_texture(filename, Sampler());
-    texture->m_cache_key = key;
+    register_texture(*texture, key);
     m_image_textures[key] = texture;
   }
 
@@ -231,16 +328,43 @@ TextureManager::get(const std::string& _filename,
     {
       texture = create_image_texture(filename, sampler);
     }
-    texture->m_cache_key = key;
+    register_texture(*texture, key);
     m_image_textures[key] = texture;
   }
 
+  // also when the region was still cached, it was announced all the same
+  if (rect)
+  {
+    finish_region(filename);
+  }
+
   return texture;
 }
 
 void
-TextureManager::reap_cache_entry(const Texture::Key& key)
+TextureManager::register_texture(Texture& texture, const Texture::Key& key)
+{
+  texture.m_cache_key = key;
+  texture.m_memory_usage = get_texel_count(texture) * static_cast<size_t>(texture.get_bytes_per_pixel());
+  texture.m_last_used = m_frame;
+  m_resident_bytes += texture.m_memory_usage;
+  m_saved_bytes += get_texel_count(texture) * 4 - texture.m_memory_usage;
+}
+
+void
+TextureManager::reap_cache_entry(const Texture& texture)
 {
+  if (texture.m_resident)
+  {
+    m_resident_bytes -= texture.m_memory_usage;
+  }
+  else
+  {
+    m_evicted_count -= 1;
+  }
+  m_saved_bytes -= get_texel_count(texture) * 4 - texture.m_memory_usage;
+
+  const Texture::Key& key = *texture.m_cache_key;
   auto i = m_image_textures.find(key);
   if (i == m_image_textures.end())
   {
@@ -253,6 +377,365 @@ TextureManager::reap_cache_entry(const Texture::Key& key)
   }
 }
 
+bool
+TextureManager::use(const Texture& texture)
+{
+  // residency isn't part of the texture's visible state, so it can be
+  // changed through the const references the painters hold
+  auto& tex = const_cast<Texture&>(texture);
+  tex.m_last_used = m_frame;
+
+  if (tex.m_resident)
+  {
+    return true;
+  }
+  else if (m_page_in_bytes >= PAGE_IN_BUDGET)
+  {
+    if (m_prefetch.insert(*tex.m_cache_key).second && is_region(*tex.m_cache_key))
+    {
+      expect_regions(std::get<0>(*tex.m_cache_key));
+    }
+    return false;
+  }
+  else
+  {
+    return page_in(tex);
+  }
+}
+
+void
+TextureManager::prefetch(const Texture& texture)
+{
+  auto& tex = const_cast<Texture&>(texture);
+  tex.m_last_used = m_frame;
+
+  if (!tex.m_resident &&
+      m_prefetch.insert(*tex.m_cache_key).second &&
+      is_region(*tex.m_cache_key))
+  {
+    expect_regions(std::get<0>(*tex.m_cache_key));
+  }
+}
+
+void
+TextureManager::update()
+{
+  m_frame += 1;
+  m_page_in_bytes = 0;
+
+  // prefetched images are decoded in the background, only the
+  // texture creation happens here
+  const Uint64 deadline = SDL_GetPerformanceCounter() +
+    SDL_GetPerformanceFrequency() * PAGE_IN_MILLISECONDS / 1000;
+
+  for(auto it = m_prefetch.begin(); it != m_prefetch.end();)
+  {
+    if (m_page_in_bytes >= PAGE_IN_BUDGET ||
+        SDL_GetPerformanceCounter() >= deadline)
+    {
+      break;
+    }
+
+    const std::string& filename = std::get<0>(*it);
+    if (!is_image_ready(filename))
+    {
+      preload(filename);
+      ++it;
+      continue;
+    }
+
+    auto i = m_image_textures.find(*it);
+    if (i != m_image_textures.end())
+    {
+      TexturePtr texture = i->second.lock();
+      if (texture && !texture->m_resident)
+      {
+        page_in(*texture);
+      }
+    }
+    if (is_region(*it))
+    {
+      finish_region(filename);
+    }
+    it = m_prefetch.erase(it);
+  }
+
+  const size_t budget = static_cast<size_t>(g_config->texture_budget) * 1024 * 1024;
+  if (budget > 0 && m_resident_bytes > budget && m_frame >= m_next_eviction_frame)
+  {
+    evict_textures(budget);
+    m_next_eviction_frame = m_frame + EVICT_INTERVAL;
+  }
+
+  // prefetched textures were cut from freshly decoded images
+  release_surfaces();
+}
+
+void
+TextureManager::release_surfaces()
+{
+  for(auto it = m_pending_images.begin(); it != m_pending_images.end();)
+  {
+    if (m_frame - it->second.frame > PRELOAD_FRAMES &&
+        it->second.image.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      log_debug << "dropping unused preloaded image: " << it->first << std::endl;
+      it = m_pending_images.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  if (m_surfaces.empty())
+    return;
+
+  // images without announced regions only get cut up while the
+  // sprite using them is loaded, which happens within one frame
+  int released_count = 0;
+  size_t released_bytes = 0;
+  for(auto it = m_surfaces.begin(); it != m_surfaces.end();)
+  {
+    const DecodedImage& decoded = it->second;
+    if (decoded.outstanding_regions > 0 && m_frame - decoded.frame <= SURFACE_FRAMES)
+    {
+      ++it;
+      continue;
+    }
+
+    if (decoded.outstanding_regions > 0)
+    {
+      log_debug << "dropping decoded image with " << decoded.outstanding_regions
+                << " unrequested regions: " << it->first << std::endl;
+    }
+    if (decoded.image.get())
+    {
+      released_count += 1;
+      released_bytes += static_cast<size_t>(decoded.image->pitch) *
+                        static_cast<size_t>(decoded.image->h);
+    }
+    it = m_surfaces.erase(it);
+  }
+
+  if (released_count > 0)
+  {
+    log_debug << "released " << released_count << " decoded images, "
+              << released_bytes / 1024 << " KiB" << std::endl;
+    log_debug << "textures take " << m_resident_bytes / 1024 << " KiB of video memory, 16-bit formats saved "
+              << m_saved_bytes / 1024 << " KiB" << std::endl;
+  }
+}
+
+void
+TextureManager::expect_regions(const std::string& filename, int count)
+{
+  DecodedImage& decoded = m_surfaces[FileSystem::normalize(filename)];
+  decoded.outstanding_regions += count;
+  decoded.frame = m_frame;
+}
+
+void
+TextureManager::finish_region(const std::string& filename)
+{
+  auto i = m_surfaces.find(filename);
+  if (i == m_surfaces.end() || i->second.outstanding_regions == 0)
+    return;
+
+  i->second.outstanding_regions -= 1;
+  i->second.frame = m_frame;
+  if (i->second.outstanding_regions == 0)
+  {
+    m_surfaces.erase(i);
+  }
+}
+
+void
+TextureManager::preload(const std::string& _filename)
+{
+  const std::string filename = FileSystem::normalize(_filename);
+
+  auto decoded = m_surfaces.find(filename);
+  if (decoded != m_surfaces.end() && decoded->second.image.get())
+  {
+    return;
+  }
+
+  auto pending_it = m_pending_images.find(filename);
+  if (pending_it != m_pending_images.end())
+  {
+    pending_it->second.frame = m_frame;
+    return;
+  }
+
+  // a texture of the whole image that is still alive will be reused
+  auto i = m_image_textures.find(Texture::Key(filename, 0, 0, 0, 0));
+  if (i != m_image_textures.end() && !i->second.expired())
+  {
+    return;
+  }
+
+  log_debug << "preloading image: " << filename << std::endl;
+  PendingImage pending;
+  const ImageCache* cache = m_image_cache.get();
+  pending.image = m_decoder->schedule([filename, cache]{ return decode_image(filename, cache); });
+  pending.frame = m_frame;
+  m_pending_images[filename] = std::move(pending);
+}
+
+void
+TextureManager::get_preload_progress(int& ready, int& total) const
+{
+  ready = 0;
+  total = static_cast<int>(m_pending_images.size());
+  for(const auto& it : m_pending_images)
+  {
+    if (it.second.image.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      ready += 1;
+    }
+  }
+}
+
+void
+TextureManager::keep_preloaded_images()
+{
+  for(auto& it : m_pending_images)
+  {
+    it.second.frame = m_frame;
+  }
+}
+
+SDLSurfacePtr
+TextureManager::take_image(const std::string& filename)
+{
+  auto i = m_pending_images.find(filename);
+  if (i == m_pending_images.end())
+  {
+    log_debug << "loading image: " << filename << std::endl;
+    return decode_image(filename, m_image_cache.get());
+  }
+  else
+  {
+    auto image = std::move(i->second.image);
+    m_pending_images.erase(i);
+    return image.get();
+  }
+}
+
+bool
+TextureManager::is_image_ready(const std::string& filename) const
+{
+  auto decoded = m_surfaces.find(filename);
+  if (decoded != m_surfaces.end() && decoded->second.image.get())
+  {
+    return true;
+  }
+
+  auto i = m_pending_images.find(filename);
+  return (i != m_pending_images.end() &&
+          i->second.image.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+}
+
+SDLSurfacePtr
+TextureManager::load_image(const Texture::Key& key)
+{
+  const std::string& filename = std::get<0>(key);
+  const Rect rect(std::get<1>(key), std::get<2>(key), std::get<3>(key), std::get<4>(key));
+
+  if (rect.get_width() == 0 || rect.get_height() == 0)
+  {
+    return take_image(filename);
+  }
+  else
+  {
+    auto& surface = const_cast<SDL_Surface&>(get_surface(filename));
+
+    SDLSurfacePtr subimage = SDLSurface::create_rgba(rect.get_width(), rect.get_height());
+    SDL_Rect src_rect = { rect.left, rect.top, rect.get_width(), rect.get_height() };
+    SDL_SetSurfaceBlendMode(&surface, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(&surface, &src_rect, subimage.get(), nullptr);
+    return subimage;
+  }
+}
+
+bool
+TextureManager::page_in(Texture& texture)
+{
+  assert(!texture.m_resident);
+
+  SDLSurfacePtr image;
+  try
+  {
+    image = load_image(*texture.m_cache_key);
+  }
+  catch(const std::exception& err)
+  {
+    // the texture has to keep its size, so an empty image is the best
+    // that can be done here
+    log_warning << "Couldn't page in texture '" << std::get<0>(*texture.m_cache_key) << "': " << err.what() << std::endl;
+    image = SDLSurface::create_rgba(texture.get_image_width(), texture.get_image_height());
+  }
+
+  try
+  {
+    texture.reload(*image);
+  }
+  catch(const std::exception& err)
+  {
+    log_warning << "Couldn't page in texture '" << std::get<0>(*texture.m_cache_key) << "': " << err.what() << std::endl;
+    return false;
+  }
+
+  texture.m_resident = true;
+  m_resident_bytes += texture.m_memory_usage;
+  m_page_in_bytes += texture.m_memory_usage;
+  m_evicted_count -= 1;
+  return true;
+}
+
+void
+TextureManager::evict_textures(size_t budget)
+{
+  std::vector<TexturePtr> candidates;
+  for(const auto& entry : m_image_textures)
+  {
+    TexturePtr texture = entry.second.lock();
+    if (texture &&
+        texture->m_resident &&
+        texture->m_evictable &&
+        m_frame - texture->m_last_used > EVICT_FRAMES)
+    {
+      candidates.push_back(texture);
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const TexturePtr& lhs, const TexturePtr& rhs) {
+              return lhs->m_last_used < rhs->m_last_used;
+            });
+
+  // evict down to a bit below the budget, so that paging textures
+  // back in doesn't immediately trigger the next eviction
+  const size_t target = budget / 10 * 9;
+
+  size_t evicted_bytes = 0;
+  for(const auto& texture : candidates)
+  {
+    if (m_resident_bytes <= target)
+      break;
+
+    texture->release();
+    texture->m_resident = false;
+    m_resident_bytes -= texture->m_memory_usage;
+    m_evicted_count += 1;
+    evicted_bytes += texture->m_memory_usage;
+  }
+
+  log_debug << "evicted " << evicted_bytes / 1024 << " KiB of textures, "
+            << m_resident_bytes / 1024 << " KiB resident" << std::endl;
+}
+
 TexturePtr
 TextureManager::create_image_texture(const std::string& filename, const Rect& rect, const Sampler& sampler)
 {
@@ -270,23 +753,20 @@ TextureManager::create_image_texture(const std::string& filename, const Rect& re
 const SDL_Surface&
 TextureManager::get_surface(const std::string& filename)
 {
-  auto i = m_surfaces.find(filename);
-  if (i != m_surfaces.end())
+  DecodedImage& decoded = m_surfaces[filename];
+  decoded.frame = m_frame;
+  if (!decoded.image)
   {
-    return *i->second;
-  }
-  else
-  {
-    SDLSurfacePtr image = SDLSurface::from_file(filename);
+    SDLSurfacePtr image = take_image(filename);
     if (!image)
     {
       std::ostringstream msg;
       msg << "Couldn't load image '" << filename << "' :" << SDL_GetError();
       throw std::runtime_error(msg.str());
     }
-
-    return *(m_surfaces[filename] = std::move(image));
+    decoded.image = std::move(image);
   }
+  return *decoded.image;
 }
 
 TexturePtr
@@ -321,7 +801,9 @@ TextureManager::create_image_texture_raw(const std::string& filename, const Rect
     throw std::runtime_error("SDL_CreateRGBSurfaceFrom() call failed");
   }
 
-  return VideoSystem::current()->new_texture(*subimage, sampler);
+  TexturePtr texture = VideoSystem::current()->new_texture(*subimage, sampler);
+  texture->m_evictable = true;
+  return texture;
 }
 
 TexturePtr
@@ -341,7 +823,7 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Sampler& sampler)
 {
-  SDLSurfacePtr image = SDLSurface::from_file(filename);
+  SDLSurfacePtr image = take_image(filename);
   if (!image)
   {
     std::ostringstream msg;
@@ -351,6 +833,7 @@ TextureManager::create_image_texture_raw(const std::string& filename, const Samp
   else
   {
     TexturePtr texture = VideoSystem::current()->new_texture(*image, sampler);
+    texture->m_evictable = true;
     image.reset(nullptr);
     return texture;
   }
@@ -365,6 +848,8 @@ TextureManager::create_dummy_texture()
   try
   {
     TexturePtr tex = create_image_texture_raw(dummy_texture_fname, Sampler());
+    // the cache key will name the missing image, so it can't be reloaded
+    tex->m_evictable = false;
     return tex;
   }
   catch (const std::exception& err)
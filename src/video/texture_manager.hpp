@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_VIDEO_TEXTURE_MANAGER_HPP
 
 #include <config.h>
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
@@ -33,7 +34,9 @@
 #include "video/texture_ptr.hpp"
 
 class GLTexture;
+class ImageCache;
 class ReaderMapping;
+class ThreadPool;
 struct SDL_Surface;
 
 class TextureManager final : public Currenton<TextureManager>
@@ -41,6 +44,13 @@ class TextureManager final : public Currenton<TextureManager>
 public:
   friend class Texture;
 
+public:
+  /** Reads file, rect, wrap, filter and animate of a texture mapping
+      like (diffuse-texture (file "...")), this doesn't touch the
+      TextureManager, so it can happen on any thread */
+  static void parse_texture(const ReaderMapping& mapping, std::string& filename,
+                            boost::optional<Rect>& rect, Sampler& sampler);
+
 public:
   TextureManager();
   ~TextureManager();
@@ -51,9 +61,97 @@ public:
                  const boost::optional<Rect>& rect,
                  const Sampler& sampler = Sampler());
 
+  /** Starts decoding the image on a worker thread, so that a later
+      get() or region request for it doesn't have to wait for it,
+      preloading it again keeps it from getting dropped as unused */
+  void preload(const std::string& filename);
+
+  /** Counts the preloaded images that nobody asked for yet and how
+      many of them are decoded already */
+  void get_preload_progress(int& ready, int& total) const;
+
+  /** Keeps the pending preloads from getting dropped as unused, for
+      screens that wait for them over many frames */
+  void keep_preloaded_images();
+
+  /** The worker threads that decode the preloads, other loading work
+      like parsing sprites gets scheduled here as well, so that it all
+      together doesn't use more threads than there are cores */
+  ThreadPool& get_thread_pool() { return *m_decoder; }
+
+  /** Announces that \a count textures of regions of \a filename will
+      be requested, the decoded image is kept until they all have
+      been, even across frames */
+  void expect_regions(const std::string& filename, int count = 1);
+
+  /** Marks the texture as used in the current frame and pages it back
+      in when it got evicted. Returns false when the texture couldn't
+      be paged in this frame, drawing it should then be skipped. */
+  bool use(const Texture& texture);
+
+  /** Pages an evicted texture back in ahead of its first use */
+  void prefetch(const Texture& texture);
+
+  /** Gets called once per drawn frame, pages in prefetched textures
+      and evicts textures that weren't used for a while when the
+      resident textures exceed the texture budget */
+  void update();
+
+  bool has_evicted_textures() const { return m_evicted_count > 0; }
+
+  /** Video memory taken by the cached textures */
+  size_t get_resident_bytes() const { return m_resident_bytes; }
+
+  /** Video memory the cached textures would take on top of
+      get_resident_bytes() if they were all stored as 32-bit RGBA */
+  size_t get_saved_bytes() const { return m_saved_bytes; }
+
 private:
+  struct PendingImage
+  {
+    std::future<SDLSurfacePtr> image;
+
+    /** frame in which the decoding got queued */
+    int frame;
+  };
+
+  struct DecodedImage
+  {
+    DecodedImage() : image(), outstanding_regions(0), frame(0) {}
+
+    /** nullptr until the first region gets cut from it */
+    SDLSurfacePtr image;
+
+    /** announced region requests that haven't happened yet */
+    int outstanding_regions;
+
+    /** last frame a region got announced or cut */
+    int frame;
+  };
+
+private:
+  /** Returns the decoded image, waiting for a preload when one is
+      running, throws on error */
+  SDLSurfacePtr take_image(const std::string& filename);
+  bool is_image_ready(const std::string& filename) const;
+
   const SDL_Surface& get_surface(const std::string& filename);
-  void reap_cache_entry(const Texture::Key& key);
+
+  /** Counts off an announced region of \a filename, the decoded image
+      is freed when it was the last one */
+  void finish_region(const std::string& filename);
+  void register_texture(Texture& texture, const Texture::Key& key);
+  void reap_cache_entry(const Texture& texture);
+
+  /** Recreates the image a cached texture was created from */
+  SDLSurfacePtr load_image(const Texture::Key& key);
+  bool page_in(Texture& texture);
+  void evict_textures(size_t budget);
+
+  /** Frees the decoded images nobody announced further regions of,
+      and as a backstop the ones whose announced regions didn't get
+      requested for a while */
+  void release_surfaces();
 
   TexturePtr create_image_texture(const std::string& filename, const Rect& rect, const Sampler& sampler);
 
@@ -68,7 +166,36 @@ private:
 
 private:
   std::map<Texture::Key, std::weak_ptr<Texture> > m_image_textures;
-  std::map<std::string, SDLSurfacePtr> m_surfaces;
+  /** nullptr when the texture cache is disabled */
+  std::unique_ptr<ImageCache> m_image_cache;
+
+  std::unique_ptr<ThreadPool> m_decoder;
+
+  /** preloaded images that nobody asked for yet */
+  std::map<std::string, PendingImage> m_pending_images;
+
+  /** decoded images that sub-rect textures are cut from, they stay
+      around until their announced regions are uploaded, or until the
+      end of the frame when there are none */
+  std::map<std::string, DecodedImage> m_surfaces;
+
+  /** counts drawn frames, to find textures that weren't used recently */
+  int m_frame;
+  int m_next_eviction_frame;
+
+  /** video memory taken by resident cached textures */
+  size_t m_resident_bytes;
+
+  /** video memory saved by storing textures in 16-bit formats */
+  size_t m_saved_bytes;
+
+  /** video memory paged in during the current frame */
+  size_t m_page_in_bytes;
+
+  int m_evicted_count;
+
+  /** evicted textures that should be paged in on the next update() */
+  std::set<Texture::Key> m_prefetch;
 };
 
 #endif
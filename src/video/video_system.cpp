@@ -16,6 +16,7 @@
 
 #include "video/video_system.hpp"
 
+#include <algorithm>
 #include <assert.h>
 #include <boost/optional.hpp>
 #include <config.h>
@@ -23,10 +24,13 @@
 #include <physfs.h>
 #include <sstream>
 
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "video/sdl/sdl_video_system.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/sdl_surface_ptr.hpp"
+#include "video/viewport.hpp"
 
 #ifdef HAVE_OPENGL
 #  include "video/gl/gl_video_system.hpp"
@@ -136,6 +140,31 @@ VideoSystem::get_video_string(VideoSystem::Enum video)
   }
 }
 
+int
+VideoSystem::get_lightmap_downscale(const Viewport& viewport)
+{
+  if (g_config->lightmap_downscale > 0)
+  {
+    return g_config->lightmap_downscale;
+  }
+  else
+  {
+    // never finer than the fixed 1/5 the lightmap always had, on
+    // large windows keep it around 320 texels wide, beyond that
+    // additional resolution isn't visible in the light sprites
+    return std::max(5, viewport.get_screen_width() / 320);
+  }
+}
+
+float
+VideoSystem::get_scene_downscale(const Viewport& viewport, float scale)
+{
+  // the scale is relative to the window, which can be bigger or
+  // smaller than the logical screen
+  return static_cast<float>(viewport.get_screen_width()) /
+    (static_cast<float>(viewport.get_rect().get_width()) * scale);
+}
+
 void
 VideoSystem::do_take_screenshot()
 {
@@ -56,11 +56,29 @@ public:
   virtual Renderer& get_renderer() const = 0;
   virtual Renderer& get_lightmap() const = 0;
 
+  /** Returns the offscreen renderer the scene is drawn into while it
+      is rendered below native resolution, nullptr otherwise */
+  virtual Renderer* get_scene_renderer() const = 0;
+
+  /** Set the resolution the scene is rendered at relative to the
+      native resolution of the window, overlays like the HUD and
+      menus are always drawn at native resolution */
+  virtual void set_scene_scale(float scale) = 0;
+
   virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler& sampler = Sampler()) = 0;
 
+  /** Creates an offscreen renderer, the result of the rendering is
+      available with Renderer::get_texture() */
+  virtual std::unique_ptr<Renderer> new_texture_renderer(const Size& size, int downscale) = 0;
+
   virtual const Viewport& get_viewport() const = 0;
   virtual void apply_config() = 0;
   virtual void flip() = 0;
+
+  /** Blocks until the rendering commands issued so far have been
+      executed, so that a frame can be timed including the work the
+      driver defers to the swap */
+  virtual void finish() = 0;
   virtual void on_resize(int w, int h) = 0;
 
   virtual void set_vsync(int mode) = 0;
@@ -72,6 +90,16 @@ public:
 
   void do_take_screenshot();
 
+  /** Returns the factor by which the lightmap is downscaled relative
+      to the logical screen. Lighting is low-frequency, so in auto
+      mode larger screens get a coarser lightmap that is bilinearly
+      upscaled when it is composited. */
+  static int get_lightmap_downscale(const Viewport& viewport);
+
+  /** Returns the factor by which the scene renderer is downscaled
+      relative to the logical screen for the given \a scale */
+  static float get_scene_downscale(const Viewport& viewport, float scale);
+
 private:
   VideoSystem(const VideoSystem&) = delete;
   VideoSystem& operator=(const VideoSystem&) = delete;
@@ -33,6 +33,7 @@
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_loading_screen.hpp"
 #include "supertux/menu/menu_storage.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/savegame.hpp"
@@ -426,7 +427,7 @@ WorldMap::update(float delta)
 
         // update state and savegame
         save_state();
-        ScreenManager::current()->push_screen(std::make_unique<GameSession>(levelfile, m_savegame, &level_->statistics),
+        ScreenManager::current()->push_screen(std::make_unique<LevelLoadingScreen>(levelfile, m_savegame, &level_->statistics),
                                               std::make_unique<ShrinkFade>(shrinkpos, 1.0f));
         m_in_level = true;
       } catch(std::exception& e) {
@@ -716,6 +717,12 @@ WorldMap::save_state()
   state.save_state();
 }
 
+bool
+WorldMap::needs_redraw() const
+{
+  return m_panning || m_tux->is_moving();
+}
+
 } // namespace worldmap
 
 /* EOF */
@@ -180,6 +180,9 @@ public:
 
   bool is_panning() const { return m_panning; }
 
+  /** true while Tux walks or the camera pans */
+  bool needs_redraw() const;
+
 protected:
   virtual bool before_object_add(const GameObjectPtr& object) override;
   virtual void before_object_remove(const GameObjectPtr& object) override;
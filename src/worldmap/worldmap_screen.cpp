@@ -55,6 +55,12 @@ WorldMapScreen::update(float delta)
   m_worldmap->update(delta);
 }
 
+bool
+WorldMapScreen::needs_redraw() const
+{
+  return m_worldmap->needs_redraw();
+}
+
 } // namespace worldmap
 
 /* EOF */
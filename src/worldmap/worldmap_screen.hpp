@@ -39,6 +39,7 @@ public:
 
   virtual void draw(Compositor& compositor) override;
   virtual void update(float delta) override;
+  virtual bool needs_redraw() const override;
 
 private:
   std::unique_ptr<WorldMap> m_worldmap;
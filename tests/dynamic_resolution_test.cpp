@@ -0,0 +1,86 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "video/dynamic_resolution.hpp"
+
+namespace {
+
+void feed(DynamicResolution& dynres, float frame_time, int frames)
+{
+  for (int i = 0; i < frames; ++i)
+  {
+    dynres.update(frame_time);
+  }
+}
+
+} // namespace
+
+TEST(DynamicResolutionTest, stays_native_within_budget)
+{
+  DynamicResolution dynres;
+  dynres.set_budget(0.016f);
+  feed(dynres, 0.008f, 200);
+  ASSERT_EQ(1.0f, dynres.get_scale());
+}
+
+TEST(DynamicResolutionTest, lowers_scale_when_over_budget)
+{
+  DynamicResolution dynres;
+  dynres.set_budget(0.016f);
+
+  feed(dynres, 0.030f, DynamicResolution::s_settle_frames);
+  ASSERT_EQ(1.0f - DynamicResolution::s_scale_step, dynres.get_scale());
+
+  feed(dynres, 0.030f, 1000);
+  ASSERT_EQ(DynamicResolution::s_min_scale, dynres.get_scale());
+}
+
+TEST(DynamicResolutionTest, raises_scale_with_headroom)
+{
+  DynamicResolution dynres;
+  dynres.set_budget(0.016f);
+
+  feed(dynres, 0.030f, 1000);
+  ASSERT_EQ(DynamicResolution::s_min_scale, dynres.get_scale());
+
+  feed(dynres, 0.004f, 1000);
+  ASSERT_EQ(1.0f, dynres.get_scale());
+}
+
+TEST(DynamicResolutionTest, no_oscillation_near_budget)
+{
+  DynamicResolution dynres;
+  dynres.set_budget(0.016f);
+
+  // a frame time just under the threshold would exceed it after
+  // raising the scale, so it must not be raised
+  feed(dynres, 0.030f, 1000);
+  const float scale = dynres.get_scale();
+  feed(dynres, 0.013f, 1000);
+  ASSERT_EQ(scale, dynres.get_scale());
+}
+
+TEST(DynamicResolutionTest, reset)
+{
+  DynamicResolution dynres;
+  feed(dynres, 1.0f, 1000);
+  dynres.reset();
+  ASSERT_EQ(1.0f, dynres.get_scale());
+}
+
+/* EOF */
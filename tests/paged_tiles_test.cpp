@@ -0,0 +1,176 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "math/rect.hpp"
+#include "util/paged_tiles.hpp"
+
+namespace {
+
+std::vector<uint32_t> make_tiles(int width, int height)
+{
+  std::vector<uint32_t> tiles(width * height, 0);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      // leave the top left page empty
+      if (x >= PagedTiles::PAGE_SIZE || y >= PagedTiles::PAGE_SIZE)
+        tiles[y * width + x] = static_cast<uint32_t>((x / 3 + y) % 7);
+    }
+  }
+  return tiles;
+}
+
+} // namespace
+
+TEST(PagedTilesTest, round_trip)
+{
+  const auto tiles = make_tiles(100, 45);
+
+  PagedTiles paged;
+  paged.assign(100, 45, tiles);
+  ASSERT_EQ(tiles, paged.get_all());
+
+  paged.assign(100, 45, tiles, true);
+  ASSERT_EQ(0, paged.get_unpacked_page_count());
+  ASSERT_EQ(tiles, paged.get_all());
+
+  for (int y = 0; y < 45; ++y)
+  {
+    for (int x = 0; x < 100; ++x)
+    {
+      ASSERT_EQ(tiles[y * 100 + x], paged.get(x, y));
+    }
+  }
+}
+
+TEST(PagedTilesTest, empty_pages_take_no_memory)
+{
+  PagedTiles paged;
+  paged.assign(1024, 1024, std::vector<uint32_t>(1024 * 1024, 0));
+  ASSERT_EQ(0, paged.get_unpacked_page_count());
+  ASSERT_LT(paged.get_memory_usage(), 1024u * 1024u);
+
+  ASSERT_EQ(0u, paged.get(500, 500));
+  ASSERT_EQ(0, paged.get_unpacked_page_count());
+
+  paged.set(500, 500, 0);
+  ASSERT_EQ(0, paged.get_unpacked_page_count());
+
+  paged.set(500, 500, 42);
+  ASSERT_EQ(1, paged.get_unpacked_page_count());
+  ASSERT_EQ(42u, paged.get(500, 500));
+}
+
+TEST(PagedTilesTest, pack_outside)
+{
+  const auto tiles = make_tiles(128, 128);
+
+  PagedTiles paged;
+  paged.assign(128, 128, tiles);
+  ASSERT_EQ(15, paged.get_unpacked_page_count());
+
+  paged.pack_outside(Rect(40, 40, 50, 50));
+  ASSERT_EQ(1, paged.get_unpacked_page_count());
+
+  // packed pages come back on access
+  ASSERT_EQ(tiles[100 * 128 + 100], paged.get(100, 100));
+  ASSERT_EQ(2, paged.get_unpacked_page_count());
+
+  paged.set(0, 0, 0);
+  paged.pack_outside(Rect(0, 0, 0, 0));
+  ASSERT_EQ(0, paged.get_unpacked_page_count());
+  ASSERT_EQ(tiles, paged.get_all());
+}
+
+TEST(PagedTilesTest, transform)
+{
+  const auto tiles = make_tiles(70, 70);
+
+  PagedTiles paged;
+  paged.assign(70, 70, tiles, true);
+  paged.transform([](uint32_t id) { return id == 3 ? 30 : id; });
+
+  auto expected = tiles;
+  std::replace(expected.begin(), expected.end(), 3u, 30u);
+  ASSERT_EQ(expected, paged.get_all());
+
+  paged.transform([](uint32_t id) { return id + 1; });
+  ASSERT_EQ(1u, paged.get(0, 0));
+}
+
+TEST(PagedTilesTest, palette)
+{
+  const auto tiles = make_tiles(64, 64);
+
+  PagedTiles paged;
+  paged.assign(64, 64, tiles);
+  ASSERT_EQ(1, paged.get_index_size());
+  ASSERT_EQ(7u, paged.get_palette_size());
+
+  // new ids widen the pages that are unpacked and the packed ones
+  paged.pack_outside(Rect(0, 0, 1, 1));
+  auto expected = tiles;
+  for (uint32_t i = 0; i < 300; ++i)
+  {
+    paged.set(i % 64, 40 + i / 64, 1000 + i);
+    expected[(40 + i / 64) * 64 + i % 64] = 1000 + i;
+  }
+  ASSERT_EQ(2, paged.get_index_size());
+  ASSERT_EQ(expected, paged.get_all());
+  for (int y = 0; y < 64; ++y)
+  {
+    for (int x = 0; x < 64; ++x)
+    {
+      ASSERT_EQ(expected[y * 64 + x], paged.get(x, y));
+    }
+  }
+
+  // reloading drops the ids that are no longer used
+  paged.assign(64, 64, tiles);
+  ASSERT_EQ(1, paged.get_index_size());
+}
+
+TEST(PagedTilesTest, undo_by_index)
+{
+  const auto tiles = make_tiles(64, 64);
+
+  PagedTiles paged;
+  paged.assign(64, 64, tiles);
+
+  // 1 and 2 both become 5, the indices still tell them apart
+  const std::vector<uint32_t> palette = paged.get_palette();
+  paged.transform([](uint32_t id) { return (id == 1 || id == 2) ? 5 : id; });
+
+  const uint32_t old_index = paged.get_index_at(40, 40);
+  paged.set(40, 40, 99);
+  ASSERT_EQ(99u, paged.get(40, 40));
+
+  paged.set_index_at(40, 40, old_index);
+  for (uint32_t i = 0; i < palette.size(); ++i)
+  {
+    if (paged.get_palette()[i] != palette[i])
+      paged.set_palette_entry(i, palette[i]);
+  }
+  ASSERT_EQ(tiles, paged.get_all());
+}
+
+/* EOF */
@@ -0,0 +1,61 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include "util/perfect_hash_map.hpp"
+
+TEST(PerfectHashMapTest, find)
+{
+  std::vector<std::pair<std::string, int> > entries;
+  for (int i = 0; i < 100; ++i)
+  {
+    entries.emplace_back("action-" + std::to_string(i), i);
+  }
+
+  PerfectHashMap<int> map;
+  map.build(entries);
+  for (int i = 0; i < 100; ++i)
+  {
+    const int* value = map.find("action-" + std::to_string(i));
+    ASSERT_NE(nullptr, value);
+    ASSERT_EQ(i, *value);
+  }
+
+  ASSERT_EQ(nullptr, map.find("action-100"));
+  ASSERT_EQ(nullptr, map.find(""));
+}
+
+TEST(PerfectHashMapTest, duplicates_keep_last)
+{
+  PerfectHashMap<int> map;
+  map.build({ { "left", 1 }, { "right", 2 }, { "left", 3 } });
+  ASSERT_EQ(3, *map.find("left"));
+  ASSERT_EQ(2, *map.find("right"));
+}
+
+TEST(PerfectHashMapTest, empty)
+{
+  PerfectHashMap<int> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(nullptr, map.find("normal"));
+
+  map.build({});
+  ASSERT_EQ(nullptr, map.find("normal"));
+}
+
+/* EOF */
@@ -120,4 +120,144 @@ TEST(ReaderTest, syntax_error)
   ASSERT_THROW({mymapping->get("b", myint);}, std::runtime_error);
 }
 
+TEST(ReaderTest, get_indexed)
+{
+  // enough keys for the mapping to be indexed
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (k1 1) (k2 2) (k3 3) (k4 4) (k5 5) (k6 6)\n"
+    "   (k7 7) (k8 8) (k9 9) (k10 10) (k1 11)\n"
+    "   (42 err) (k12 12)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  int value;
+  ASSERT_TRUE(mapping.get("k5", value));
+  ASSERT_EQ(5, value);
+  ASSERT_TRUE(mapping.get("k10", value));
+  ASSERT_EQ(10, value);
+
+  // the first of duplicate keys wins
+  ASSERT_TRUE(mapping.get("k1", value));
+  ASSERT_EQ(1, value);
+
+  // keys behind a malformed entry can't be reached
+  ASSERT_THROW({mapping.get("k12", value);}, std::runtime_error);
+  ASSERT_THROW({mapping.get("missing", value);}, std::runtime_error);
+}
+
+TEST(ReaderTest, get_packed_array)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (tiles 0 1 2 3 4 5 6 7\n"
+    "          8 9 10 11 12 13 14 15 16)\n"
+    "   (ids 1 2 3)\n"
+    "   (mystring \"(tiles 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16)\")\n"
+    "   (myint 42 err)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  std::vector<unsigned int> tiles;
+  ASSERT_TRUE(mapping.get("tiles", tiles));
+  ASSERT_EQ(17u, tiles.size());
+  ASSERT_EQ(0u, tiles[0]);
+  ASSERT_EQ(16u, tiles[16]);
+
+  std::vector<int> ids;
+  ASSERT_TRUE(mapping.get("ids", ids));
+  ASSERT_EQ(std::vector<int>({1, 2, 3}), ids);
+
+  std::string mystring;
+  mapping.get("mystring", mystring);
+  ASSERT_EQ("(tiles 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16)", mystring);
+
+  // line numbers in error messages stay the same
+  int myint;
+  try
+  {
+    mapping.get("myint", myint);
+    FAIL();
+  }
+  catch(const std::exception& err)
+  {
+    ASSERT_NE(std::string::npos, std::string(err.what()).find("<stream>:6:"));
+  }
+}
+
+TEST(ReaderTest, compiled_round_trip)
+{
+  std::istringstream in(
+    "(supertux-level\n"
+    "   (version 2)\n"
+    "   (name (_ \"Round Trip\"))\n"
+    "   (sector\n"
+    "     (name \"main\")\n"
+    "     (gravity 10.5)\n"
+    "     (tilemap (solid #t) (width 4) (height 4)\n"
+    "       (tiles 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 4294967)))\n"
+    "   (empty)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+
+  std::stringstream compiled;
+  doc.write_compiled(compiled, ReaderDocument::CompiledSource{ 0, 0 });
+  auto compiled_doc = ReaderDocument::from_compiled_stream(compiled);
+
+  ASSERT_TRUE(doc.get_root().get_mapping().get_sexp() == compiled_doc.get_root().get_mapping().get_sexp());
+
+  auto level = compiled_doc.get_root().get_mapping();
+  int version;
+  ASSERT_TRUE(level.get("version", version));
+  ASSERT_EQ(2, version);
+
+  std::string name;
+  ASSERT_TRUE(level.get("name", name));
+  ASSERT_EQ("Round Trip", name);
+
+  boost::optional<ReaderMapping> sector;
+  ASSERT_TRUE(level.get("sector", sector));
+  float gravity;
+  ASSERT_TRUE(sector->get("gravity", gravity));
+  ASSERT_EQ(10.5f, gravity);
+
+  boost::optional<ReaderMapping> tilemap;
+  ASSERT_TRUE(sector->get("tilemap", tilemap));
+  bool solid;
+  ASSERT_TRUE(tilemap->get("solid", solid));
+  ASSERT_TRUE(solid);
+
+  std::vector<unsigned int> tiles;
+  std::vector<unsigned int> expected;
+  doc.get_root().get_mapping().get("sector", sector);
+  sector->get("tilemap", tilemap);
+  tilemap->get("tiles", expected);
+  ASSERT_TRUE(compiled_doc.get_root().get_mapping().get("sector", sector));
+  ASSERT_TRUE(sector->get("tilemap", tilemap));
+  ASSERT_TRUE(tilemap->get("tiles", tiles));
+  ASSERT_EQ(16u, tiles.size());
+  ASSERT_EQ(expected, tiles);
+}
+
+TEST(ReaderTest, compiled_corrupt)
+{
+  std::istringstream in("(supertux-level (version 2) (name \"x\"))");
+  auto doc = ReaderDocument::from_stream(in);
+
+  std::stringstream compiled;
+  doc.write_compiled(compiled, ReaderDocument::CompiledSource{ 0, 0 });
+  std::string data = compiled.str();
+
+  std::istringstream truncated(data.substr(0, data.size() - 3));
+  ASSERT_THROW(ReaderDocument::from_compiled_stream(truncated), std::runtime_error);
+
+  std::istringstream text("(supertux-level)");
+  ASSERT_THROW(ReaderDocument::from_compiled_stream(text), std::runtime_error);
+}
+
 /* EOF */
@@ -0,0 +1,101 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "supertux/snapshot.hpp"
+#include "supertux/snapshot_buffer.hpp"
+
+namespace {
+
+std::vector<uint8_t> make_state(int frame)
+{
+  SnapshotWriter writer;
+  for (int i = 0; i < 64; ++i)
+  {
+    // only a few values change from frame to frame
+    writer.write(i % 8 == 0 ? static_cast<float>(frame * i) : static_cast<float>(i));
+  }
+  writer.write(std::string(static_cast<size_t>(frame % 3), 'x'));
+  return writer.release();
+}
+
+} // namespace
+
+TEST(SnapshotBufferTest, get)
+{
+  SnapshotBuffer buffer(100, 10);
+  for (int frame = 0; frame < 25; ++frame)
+    buffer.push(make_state(frame));
+
+  ASSERT_EQ(25u, buffer.size());
+  for (int age = 0; age < 25; ++age)
+  {
+    ASSERT_EQ(make_state(24 - age), buffer.get(static_cast<size_t>(age)));
+  }
+  ASSERT_THROW(buffer.get(25), std::out_of_range);
+
+  // deltas are much smaller than three full keyframes plus 22 copies
+  ASSERT_LT(buffer.get_memory_usage(), make_state(0).size() * 6);
+}
+
+TEST(SnapshotBufferTest, eviction)
+{
+  SnapshotBuffer buffer(20, 5);
+  for (int frame = 0; frame < 100; ++frame)
+  {
+    buffer.push(make_state(frame));
+    ASSERT_LE(buffer.size(), 20u);
+    ASSERT_EQ(make_state(frame), buffer.get(0));
+  }
+  ASSERT_EQ(make_state(100 - buffer.size()), buffer.get(buffer.size() - 1));
+}
+
+TEST(SnapshotBufferTest, drop_newest)
+{
+  SnapshotBuffer buffer(100, 4);
+  for (int frame = 0; frame < 10; ++frame)
+    buffer.push(make_state(frame));
+
+  buffer.drop_newest(3);
+  ASSERT_EQ(7u, buffer.size());
+  ASSERT_EQ(make_state(6), buffer.get(0));
+
+  for (int frame = 100; frame < 110; ++frame)
+    buffer.push(make_state(frame));
+  ASSERT_EQ(make_state(109), buffer.get(0));
+  ASSERT_EQ(make_state(6), buffer.get(10));
+}
+
+TEST(SnapshotBufferTest, reader)
+{
+  SnapshotWriter writer;
+  writer.write(42);
+  writer.write(std::string("hello"));
+  const auto data = writer.release();
+
+  SnapshotReader reader(data.data(), data.size());
+  int i;
+  std::string s;
+  reader.read(i);
+  reader.read(s);
+  ASSERT_EQ(42, i);
+  ASSERT_EQ("hello", s);
+  ASSERT_TRUE(reader.eof());
+  ASSERT_THROW(reader.read(i), std::runtime_error);
+}
+
+/* EOF */
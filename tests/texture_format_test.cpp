@@ -0,0 +1,73 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include "video/texture_format.hpp"
+
+namespace {
+
+std::vector<uint8_t> make_image(std::initializer_list<uint32_t> colors)
+{
+  std::vector<uint8_t> pixels;
+  for (uint32_t color : colors)
+  {
+    pixels.push_back(static_cast<uint8_t>(color >> 24));
+    pixels.push_back(static_cast<uint8_t>(color >> 16));
+    pixels.push_back(static_cast<uint8_t>(color >> 8));
+    pixels.push_back(static_cast<uint8_t>(color));
+  }
+  return pixels;
+}
+
+TextureFormat choose(const std::vector<uint8_t>& pixels)
+{
+  const int width = static_cast<int>(pixels.size() / 4);
+  return choose_texture_format(pixels.data(), width, 1, width * 4);
+}
+
+} // namespace
+
+TEST(TextureFormatTest, choose_texture_format)
+{
+  ASSERT_EQ(TextureFormat::RGB565, choose(make_image({ 0x000000ff, 0xffffffff, 0xff0000ff })));
+  ASSERT_EQ(TextureFormat::RGB565, choose(make_image({ 0x84b2d6ff })));
+  ASSERT_EQ(TextureFormat::RGBA4444, choose(make_image({ 0x11223344, 0xffffff00 })));
+  ASSERT_EQ(TextureFormat::RGBA8888, choose(make_image({ 0x123456ff, 0x11223344 })));
+  ASSERT_EQ(TextureFormat::RGBA8888, choose(make_image({ 0x000000ff, 0x00000080 })));
+}
+
+TEST(TextureFormatTest, choose_texture_format_pitch)
+{
+  // the padding at the end of each row isn't part of the image
+  std::vector<uint8_t> pixels = make_image({ 0xffffffff, 0x12345678,
+                                             0x000000ff, 0x12345678 });
+  ASSERT_EQ(TextureFormat::RGB565, choose_texture_format(pixels.data(), 1, 2, 8));
+}
+
+TEST(TextureFormatTest, pack_pixels)
+{
+  std::vector<uint8_t> pixels = make_image({ 0xff0000ff, 0x00ff00ff, 0x0000ffff });
+  ASSERT_EQ(std::vector<uint16_t>({ 0xf800, 0x07e0, 0x001f }),
+            pack_pixels(TextureFormat::RGB565, pixels.data(), 3, 1, 12));
+
+  pixels = make_image({ 0x11223344, 0xffffff00 });
+  ASSERT_EQ(std::vector<uint16_t>({ 0x1234, 0xfff0 }),
+            pack_pixels(TextureFormat::RGBA4444, pixels.data(), 2, 1, 8));
+}
+
+/* EOF */
@@ -0,0 +1,64 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "util/thread_pool.hpp"
+
+TEST(ThreadPoolTest, returns_results)
+{
+  ThreadPool pool(2);
+
+  auto a = pool.schedule([]{ return 6 * 7; });
+  auto b = pool.schedule([]{ return std::string("decoded"); });
+
+  ASSERT_EQ(42, a.get());
+  ASSERT_EQ("decoded", b.get());
+}
+
+TEST(ThreadPoolTest, runs_all_jobs)
+{
+  ThreadPool pool(4);
+  std::atomic<int> counter(0);
+
+  std::vector<std::future<void> > futures;
+  for (int i = 0; i < 100; ++i)
+  {
+    futures.push_back(pool.schedule([&counter]{ counter += 1; }));
+  }
+
+  for (auto& future : futures)
+  {
+    future.wait();
+  }
+
+  ASSERT_EQ(100, counter.load());
+}
+
+TEST(ThreadPoolTest, forwards_exceptions)
+{
+  ThreadPool pool(1);
+
+  auto future = pool.schedule([]() -> int { throw std::runtime_error("broken image"); });
+
+  ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+/* EOF */
@@ -0,0 +1,75 @@
+//  SuperTux
+//  Copyright (C) 2026 agent <agent@local>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "util/tile_encoding.hpp"
+
+TEST(TileEncodingTest, round_trip)
+{
+  std::vector<std::vector<uint32_t> > inputs = {
+    {},
+    { 0 },
+    { 1, 2, 3 },
+    { 0, 0, 0, 0, 0, 0, 0, 7, 7, 7, 0, 0 },
+    { 127, 128, 16383, 16384, 0xffffffff }
+  };
+  for (const auto& tiles : inputs)
+  {
+    ASSERT_EQ(tiles, TileEncoding::decode(TileEncoding::encode(tiles), tiles.size()));
+  }
+}
+
+TEST(TileEncodingTest, runs_are_compact)
+{
+  std::vector<uint32_t> tiles(10000, 0);
+  tiles.insert(tiles.end(), 500, 42);
+  const std::string encoded = TileEncoding::encode(tiles);
+  ASSERT_EQ("kE4A9AMq", encoded);
+  ASSERT_EQ(tiles, TileEncoding::decode(encoded, tiles.size()));
+}
+
+TEST(TileEncodingTest, malformed)
+{
+  ASSERT_THROW(TileEncoding::decode("!!!!", 0), std::runtime_error);
+  // a run without an id
+  ASSERT_THROW(TileEncoding::decode("Ag==", 2), std::runtime_error);
+  // a run of length zero
+  ASSERT_THROW(TileEncoding::decode("AAE=", 0), std::runtime_error);
+}
+
+TEST(TileEncodingTest, wrong_count)
+{
+  const std::string encoded = TileEncoding::encode(std::vector<uint32_t>(100, 3));
+  ASSERT_THROW(TileEncoding::decode(encoded, 99), std::runtime_error);
+  ASSERT_THROW(TileEncoding::decode(encoded, 101), std::runtime_error);
+
+  // a single run of 2^32-1 tiles must fail before allocating them
+  std::vector<uint32_t> tiles;
+  ASSERT_THROW(TileEncoding::decode_runs(std::string("\xff\xff\xff\xff\x0f\x01", 6), 16, tiles),
+               std::runtime_error);
+  ASSERT_LE(tiles.size(), 16u);
+
+  // a huge tilemap size with no data behind it mustn't reserve it
+  ASSERT_THROW(TileEncoding::decode_runs(std::string(), static_cast<size_t>(100000) * 100000, tiles),
+               std::runtime_error);
+  ASSERT_EQ(tiles.capacity(), 0u);
+}
+
+/* EOF */